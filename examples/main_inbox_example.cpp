@@ -0,0 +1,88 @@
+#include <atomic>
+#include <iostream>
+
+#include "uvent/Uvent.h"
+#include "uvent/sync/AsyncEvent.h"
+#include "uvent/sync/AsyncSemaphore.h"
+#include "uvent/sync/AsyncWaitGroup.h"
+#include "uvent/system/SystemContext.h"
+
+using namespace usub::uvent;
+using namespace std::chrono_literals;
+
+constexpr int kThreads = 4;
+constexpr int kRounds = 10000;
+
+static usub::Uvent* g_uvent = nullptr;
+static sync::AsyncEvent g_start{sync::Reset::Manual, false};
+static sync::WaitGroup g_done;
+static std::atomic<int> g_misplaced{0};
+
+// every wake below crosses workers: the waiter's own frame is linked into the inbox of the worker it slept on
+task::Awaitable<void> waiter(int tid)
+{
+    co_await g_start.wait();
+    if (system::this_thread::detail::t_id != tid)
+        ++g_misplaced;
+    g_done.done();
+}
+
+// two coroutines on different workers hand a token back and forth through a pair of semaphores
+task::Awaitable<void> player(sync::AsyncSemaphore& mine, sync::AsyncSemaphore& theirs, int tid)
+{
+    for (int i = 0; i < kRounds; ++i)
+    {
+        co_await mine.acquire();
+        if (system::this_thread::detail::t_id != tid)
+            ++g_misplaced;
+        theirs.release();
+    }
+    g_done.done();
+}
+
+task::Awaitable<void> from_outside(int tid)
+{
+    std::cout << "[inbox] spawned from the blocking pool, running on worker "
+              << system::this_thread::detail::t_id << " (asked for " << tid << ")\n";
+    g_done.done();
+    co_return;
+}
+
+task::Awaitable<void> coordinator()
+{
+    static sync::AsyncSemaphore ping{1}, pong{0};
+
+    // co_spawn_static places each coroutine in the inbox of the given worker
+    g_done.add(kThreads);
+    for (int tid = 0; tid < kThreads; ++tid)
+        system::co_spawn_static(waiter(tid), tid);
+    co_await system::this_coroutine::sleep_for(20ms);
+    // one set() wakes all of them, batched per target worker
+    g_start.set();
+
+    g_done.add(2);
+    auto t0 = std::chrono::steady_clock::now();
+    system::co_spawn_static(player(ping, pong, 1), 1);
+    system::co_spawn_static(player(pong, ping, 2), 2);
+
+    // a thread that is not a worker, here one of the blocking pool, can post into an inbox too
+    g_done.add(1);
+    co_await system::offload([] { system::co_spawn_static(from_outside(3), 3); });
+
+    co_await g_done.wait();
+    const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "[inbox] " << 2 * kRounds << " cross-worker hand-offs in " << ms << " ms, misplaced resumes: "
+              << g_misplaced.load() << "\n";
+    g_uvent->stop();
+}
+
+int main()
+{
+    usub::Uvent uvent(kThreads);
+    g_uvent = &uvent;
+
+    system::co_spawn_static(coordinator(), 0);
+
+    uvent.run();
+    return 0;
+}
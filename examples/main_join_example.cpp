@@ -0,0 +1,79 @@
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "uvent/Uvent.h"
+#include "uvent/system/SystemContext.h"
+
+using namespace usub::uvent;
+using namespace std::chrono_literals;
+
+static usub::Uvent* g_uvent = nullptr;
+
+task::Awaitable<long> sum_shard(int shard, int size)
+{
+    co_await system::this_coroutine::sleep_for(std::chrono::milliseconds(10 * shard));
+    long sum = 0;
+    for (int i = shard * size; i < (shard + 1) * size; ++i)
+        sum += i;
+    co_return sum;
+}
+
+task::Awaitable<int> failing()
+{
+    co_await system::this_coroutine::sleep_for(5ms);
+    throw std::runtime_error("shard unavailable");
+}
+
+task::Awaitable<void> background()
+{
+    co_await system::this_coroutine::sleep_for(50ms);
+    std::cout << "[background] finished after being detached\n";
+}
+
+task::Awaitable<void> coordinator()
+{
+    constexpr int shards = 8, size = 1000;
+
+    // fan out: each shard starts on its own worker, the results stay in the children's frames
+    std::vector<task::JoinHandle<long>> handles;
+    for (int shard = 0; shard < shards; ++shard)
+        handles.push_back(system::co_spawn_joinable(sum_shard(shard, size), shard % 4));
+
+    long total = 0;
+    for (auto& h : handles)
+        total += co_await h;
+    std::cout << "[coordinator] total = " << total << " (expected " << long(shards) * size * (shards * size - 1) / 2
+              << ")\n";
+
+    // the exception a child exits with is rethrown by the join
+    auto bad = system::co_spawn_joinable(failing());
+    try
+    {
+        co_await bad;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "[coordinator] joined with exception: " << e.what() << "\n";
+    }
+
+    // dropping a handle detaches the child, which runs to completion on its own
+    {
+        auto detached = system::co_spawn_joinable(background());
+    }
+    co_await system::this_coroutine::sleep_for(100ms);
+
+    g_uvent->stop();
+}
+
+int main()
+{
+    usub::Uvent uvent(4);
+    g_uvent = &uvent;
+
+    system::co_spawn(coordinator());
+
+    uvent.run();
+    return 0;
+}
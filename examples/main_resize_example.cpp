@@ -0,0 +1,86 @@
+#include <atomic>
+#include <iostream>
+
+#include "uvent/Uvent.h"
+#include "uvent/sync/AsyncWaitGroup.h"
+#include "uvent/system/SystemContext.h"
+
+using namespace usub::uvent;
+using namespace std::chrono_literals;
+
+static usub::Uvent* g_uvent = nullptr;
+
+task::Awaitable<void> burst_task(sync::WaitGroup& wg, std::atomic<long>& work)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        long x = 0;
+        for (int k = 0; k < 20000; ++k)
+            x += k ^ i;
+        work.fetch_add(x & 1, std::memory_order_relaxed);
+        co_await system::this_coroutine::yield();
+    }
+    wg.done();
+}
+
+task::Awaitable<void> run_burst(const char* label, int tasks)
+{
+    sync::WaitGroup wg;
+    std::atomic<long> work{0};
+    wg.add(tasks);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < tasks; ++i)
+        system::co_spawn(burst_task(wg, work));
+    co_await wg.wait();
+    const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "[" << label << "] " << tasks << " tasks on " << g_uvent->active_threads() << " active workers: " << ms
+              << " ms\n";
+}
+
+void print_resumed()
+{
+    std::cout << "    resumed per worker:";
+    for (const auto& s : g_uvent->thread_stats())
+        std::cout << ' ' << s.resumed;
+    std::cout << '\n';
+}
+
+task::Awaitable<void> coordinator()
+{
+    co_await run_burst("start", 2000);
+
+    // grow: new workers join the pool and take shared work right away
+    g_uvent->resize(6);
+    co_await run_burst("grown", 2000);
+    print_resumed();
+
+    // shrink: the highest-index workers retire, their queued tasks move to the global queue
+    g_uvent->resize(2);
+    co_await system::this_coroutine::sleep_for(10ms);
+    co_await run_burst("shrunk", 2000);
+    print_resumed();
+
+    // or let the runtime pick the size from its own queue depth and idle time
+    usub::AutoscalerConfig config;
+    config.min_threads = 1;
+    config.max_threads = 6;
+    config.interval_ms = 20;
+    g_uvent->enable_autoscaler(config);
+    co_await run_burst("autoscaled", 20000);
+    co_await system::this_coroutine::sleep_for(200ms);
+    std::cout << "[idle] autoscaler settled on " << g_uvent->active_threads() << " active workers\n";
+    g_uvent->disable_autoscaler();
+
+    g_uvent->stop();
+}
+
+int main()
+{
+    usub::Uvent uvent(4);
+    g_uvent = &uvent;
+
+    system::co_spawn_static(coordinator(), 0);
+
+    uvent.run();
+    return 0;
+}
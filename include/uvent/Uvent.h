@@ -5,25 +5,188 @@
 #ifndef UVENT_UVENT_H
 #define UVENT_UVENT_H
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifndef _WIN32
+#include "uvent/fs/File.h"
+#endif
 #include "uvent/net/Socket.h"
+#include "uvent/pool/BlockingPool.h"
 #include "uvent/pool/ThreadPool.h"
+#include "uvent/tasks/JoinHandle.h"
 #include "uvent/system/SystemContext.h"
 
 namespace usub {
+    /**
+     * @brief Thresholds of the optional worker autoscaler, see `Uvent::enable_autoscaler()`.
+     */
+    struct AutoscalerConfig {
+        int min_threads{1};
+        int max_threads{static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))};
+        /// \brief Sampling period.
+        int interval_ms{1000};
+        /// \brief Grow by one worker when more tasks than this are queued per active worker.
+        double grow_queue_depth{64.0};
+        /// \brief Shrink by one worker when active workers spent more than this fraction of the period parked.
+        double shrink_idle_ratio{0.8};
+    };
+
+    /// \brief How new connections are spread over the listeners of `Uvent::listen_per_thread()`.
+    enum class ReuseportSteering {
+        /// \brief The kernel's default `SO_REUSEPORT` hash of the connection 4-tuple.
+        HASH,
+        /// \brief `SO_INCOMING_CPU` on each listener: the kernel prefers the listener of the worker pinned to the CPU
+        /// that received the SYN. Linux only; needs pinned workers.
+        INCOMING_CPU,
+        /// \brief A classic BPF program attached to the group picks the listener of the worker pinned to the receiving
+        /// CPU (`receiving CPU % listeners` for CPUs no worker is pinned to). Linux only. The pool cannot shrink while
+        /// these listeners are open, see `Uvent::listen_per_thread()`.
+        CBPF_CPU
+    };
+
+    /// \brief Listening address and options of `Uvent::listen_per_thread()`.
+    struct ListenerConfig {
+        std::string ip{"0.0.0.0"};
+        int port{8080};
+        int backlog{1024};
+        uvent::utils::net::IPV ipv{uvent::utils::net::IPV4};
+        ReuseportSteering steering{ReuseportSteering::HASH};
+    };
+
+    /// \brief Coroutine started for every accepted connection.
+    using ConnectionHandler = std::function<uvent::task::Awaitable<void>(uvent::net::TCPClientSocket)>;
+
     class Uvent : std::enable_shared_from_this<Uvent> {
     public:
         explicit Uvent(int threadCount);
 
+        /**
+         * @brief Creates a runtime whose workers are placed according to @p placement.
+         *
+         * See `uvent::system::PlacementPolicy`. `Uvent(threadCount)` uses `ThreadPlacement::from_build()`.
+         */
+        Uvent(int threadCount, const uvent::system::ThreadPlacement& placement);
+
         void stop();
 
         void run();
 
+        /**
+         * @brief Runs a single iteration of the event loop on the calling thread and returns.
+         *
+         * For embedding uvent into a loop it does not own (a game server tick, a GUI thread):
+         * the calling thread becomes the worker that `run()` would have made of it, so `Uvent(1)`
+         * needs no extra thread at all. One iteration polls I/O, resumes the ready coroutines, ticks
+         * the timer wheel, destroys finished frames and drains the inbox.
+         *
+         * When there is nothing to run it blocks in the poller for at most @p timeout (0: never blocks),
+         * without the idle spinning of `run()`. Spawns from other threads and I/O wake it early.
+         * Every call must come from the same thread, and `run()` must not be used on this instance.
+         *
+         * After `stop()`, the calling thread is released as a worker (unregistered from QSBR, its link to the
+         * worker storage dropped) by its next `poll_once()` or `run_for()`, or by the destruction of the
+         * `Uvent` if that happens on the same thread first.
+         *
+         * @return Number of coroutines resumed, 0 after `stop()`.
+         */
+        size_t poll_once(std::chrono::milliseconds timeout = std::chrono::milliseconds{0});
+
+        /**
+         * @brief Calls `poll_once()` until @p duration has elapsed or `stop()` has been called.
+         *
+         * Blocks for at most the remaining time. Same threading rules as `poll_once()`.
+         *
+         * @return Number of coroutines resumed.
+         */
+        size_t run_for(std::chrono::nanoseconds duration);
+
         void for_each_thread(std::function<void(int, uvent::thread::ThreadLocalStorage*)> f) const;
 
+        /// \brief Snapshot of every worker's runtime counters, indexed by thread.
+        [[nodiscard]] std::vector<uvent::thread::ThreadStats> thread_stats() const;
+
+        /**
+         * @brief Changes the number of active workers at runtime.
+         *
+         * Growing reactivates retired workers first and then starts new threads. Shrinking retires the
+         * highest-index workers: a retired worker hands its spawned-but-not-started tasks to the global
+         * queue and stops taking shared work, but keeps serving the sockets, timers and inbox it already
+         * owns (those are bound to its poller and timer wheel), parking when it has nothing to do.
+         * Retired threads exit with the pool.
+         *
+         * @throws std::system_error (`operation_not_supported`) when asked to shrink while listeners of
+         *         `listen_per_thread()` with `ReuseportSteering::CBPF_CPU` are open.
+         */
+        void resize(int threadCount);
+
+        /// \brief Number of workers that are not retired.
+        [[nodiscard]] int active_threads() const;
+
+        /**
+         * @brief Starts a coroutine that resizes the pool from queue depth and idle time.
+         *
+         * Every `interval_ms` it grows by one worker when the queued tasks per active worker exceed
+         * `grow_queue_depth`, or shrinks by one when active workers were parked more than
+         * `shrink_idle_ratio` of the period, staying within `[min_threads, max_threads]`.
+         *
+         * @throws std::system_error (`operation_not_supported`) while `CBPF_CPU` listeners are open.
+         */
+        void enable_autoscaler(AutoscalerConfig config = {});
+
+        void disable_autoscaler();
+
+        /**
+         * @brief Shared-nothing accept: one `SO_REUSEPORT` listener and one accept loop per active worker.
+         *
+         * The listening sockets are opened here, so bind errors are thrown to the caller as
+         * `std::system_error`. Each worker then accepts from its own listener and runs @p handler for
+         * the connection on the same worker, in its bound run queue: the accept path never hands a
+         * connection to another thread. `config.steering` selects how the kernel spreads connections.
+         *
+         * Listeners are bound to the workers active at the time of the call. `stop()` shuts all of them
+         * down, and `resize()` those of the workers it retires: their accept loops then exit and close
+         * the sockets. A listener is not reopened when its worker becomes active again.
+         *
+         * With `CBPF_CPU`, the program selects listeners by their position in the reuseport group, so
+         * they must be the only sockets of the group, and none of them may close while the others serve:
+         * the kernel would move the last listener into the hole and remap the positions. Such a pool
+         * therefore cannot shrink, and `CBPF_CPU` is refused with `std::system_error`
+         * (`operation_not_supported`) while the autoscaler is enabled.
+         */
+        void listen_per_thread(const ListenerConfig& config, ConnectionHandler handler);
+
     private:
+        /// \brief Listening sockets of `listen_per_thread()` whose accept loop has not exited yet.
+        struct Listeners {
+            std::mutex mtx;
+            /// \brief Listener fd and the worker accepting from it.
+            std::vector<std::pair<int, int>> open;
+            /// \brief `open` holds a `CBPF_CPU` group, whose program addresses listeners by position.
+            bool cbpf{false};
+
+            /// \brief Closes the listeners whose worker stopped before their accept loop could exit.
+            ~Listeners();
+        };
+
+        static uvent::task::Awaitable<void> accept_loop(int fd, std::shared_ptr<ConnectionHandler> handler,
+                                                        Listeners* listeners);
+
+        /// \brief Shuts down every listener if @p all, otherwise those of retired workers, waking their accept loops.
+        void shutdown_listeners(bool all);
+
         int thread_count_;
+        // destroyed after the pool has joined the workers, so no accept loop can still touch it
+        Listeners listeners_;
         uvent::ThreadPool pool;
+        std::atomic<uint64_t> autoscaler_generation_{0};
+        std::atomic<bool> autoscaler_enabled_{false};
     };
 }
 
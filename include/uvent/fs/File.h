@@ -0,0 +1,275 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_FILE_H
+#define UVENT_FILE_H
+
+#include <coroutine>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/types.h>
+
+#include "uvent/system/Defines.h"
+#include "uvent/system/SystemContext.h"
+
+#ifdef UVENT_ENABLE_IO_URING
+#include "uvent/poll/IOUringPoller.h"
+#endif
+
+namespace usub::uvent::fs
+{
+    class File;
+
+    namespace detail
+    {
+        enum class FileOpKind : uint8_t
+        {
+            READ_AT,
+            WRITE_AT,
+            FSYNC,
+            FDATASYNC,
+            OPEN
+        };
+
+#ifdef UVENT_ENABLE_IO_URING
+        /// \brief Submits the operation to the io_uring of the calling worker.
+        class FileOpAwaiter
+        {
+        public:
+            FileOpAwaiter(FileOpKind kind, int fd, void* buf, size_t len, uint64_t offset) noexcept
+            {
+                using core::detail::IoOpKind;
+                switch (kind)
+                {
+                    case FileOpKind::READ_AT:
+                        this->op_.kind = IoOpKind::ReadAt;
+                        break;
+                    case FileOpKind::WRITE_AT:
+                        this->op_.kind = IoOpKind::WriteAt;
+                        break;
+                    case FileOpKind::FDATASYNC:
+                        this->op_.kind = IoOpKind::Fsync;
+                        this->op_.fsync_flags = IORING_FSYNC_DATASYNC;
+                        break;
+                    default:
+                        this->op_.kind = IoOpKind::Fsync;
+                        break;
+                }
+                this->op_.fd = fd;
+                this->op_.buf = buf;
+                this->op_.len = len;
+                this->op_.offset = offset;
+            }
+
+            FileOpAwaiter(const FileOpAwaiter&) = delete;
+
+            FileOpAwaiter& operator=(const FileOpAwaiter&) = delete;
+
+            bool await_ready() const noexcept { return this->op_.fd < 0 && this->op_.kind != core::detail::IoOpKind::OpenAt; }
+
+            void await_suspend(std::coroutine_handle<> h)
+            {
+                this->op_.coro = h;
+                this->op_.priority = system::this_thread::detail::cur_priority;
+                auto& pl = static_cast<core::IOUringPoller&>(system::this_thread::detail::pl);
+                pl.submit_file(&this->op_);
+            }
+
+            /// \return bytes transferred (0 for fsync), or -errno.
+            ssize_t await_resume() noexcept
+            {
+                if (!this->op_.completed)
+                    return -EBADF;
+                return this->op_.res < 0 ? -this->op_.err : this->op_.res;
+            }
+
+        protected:
+            FileOpAwaiter() noexcept = default;
+
+            core::detail::FileOp op_{};
+        };
+#else
+        /**
+         * @brief Hands the operation to the blocking pool.
+         *
+         * Operations are not submitted one by one: they are chained on a per-worker list that goes to the
+         * pool at the start of the next loop iteration, split into a few jobs, see `flush_pending()`.
+         */
+        class FileOpAwaiter
+        {
+        public:
+            FileOpAwaiter(FileOpKind kind, int fd, void* buf, size_t len, uint64_t offset) noexcept :
+                kind_(kind), fd_(fd), buf_(buf), len_(len), offset_(offset)
+            {
+            }
+
+            FileOpAwaiter(const FileOpAwaiter&) = delete;
+
+            FileOpAwaiter& operator=(const FileOpAwaiter&) = delete;
+
+            bool await_ready() noexcept
+            {
+                if (this->fd_ >= 0 || this->kind_ == FileOpKind::OPEN)
+                    return false;
+                this->res_ = -EBADF;
+                return true;
+            }
+
+            template <class P>
+            void await_suspend(std::coroutine_handle<P> h) noexcept
+            {
+                this->suspend(h);
+            }
+
+            /// \return bytes transferred (0 for fsync), or -errno.
+            ssize_t await_resume() const noexcept { return this->res_; }
+
+            /// \brief Runs a chain of operations on the calling thread and resumes their coroutines.
+            static void run_chain(void* head) noexcept;
+
+        protected:
+            friend void flush_pending() noexcept;
+
+            FileOpAwaiter() noexcept = default;
+
+            void suspend(uvent::detail::WakeHandle h) noexcept;
+
+            void execute() noexcept;
+
+            FileOpKind kind_{FileOpKind::READ_AT};
+            int fd_{-1};
+            void* buf_{nullptr};
+            size_t len_{0};
+            uint64_t offset_{0};
+            const char* path_{nullptr};
+            int open_flags_{0};
+            mode_t mode_{0};
+            ssize_t res_{0};
+            uvent::detail::WakeHandle h_{};
+            int t_id_{-1};
+            task::Priority priority_{task::Priority::NORMAL};
+            FileOpAwaiter* next_{nullptr};
+        };
+
+        /**
+         * @brief Sends the file operations queued by the calling worker to the blocking pool.
+         *
+         * The list is cut into one chain per pool thread, each at most a few operations long, so the
+         * operations of a batch run in parallel.
+         */
+        void flush_pending() noexcept;
+#endif
+
+        class OpenAwaiter : public FileOpAwaiter
+        {
+        public:
+            OpenAwaiter(std::string path, int flags, mode_t mode) noexcept;
+
+            bool await_ready() const noexcept { return false; }
+
+            std::expected<File, int> await_resume() noexcept;
+
+        private:
+            std::string path_str_;
+        };
+    } // namespace detail
+
+    /**
+     * @brief Owning handle of an open file with asynchronous positional I/O.
+     *
+     * With the io_uring backend every operation is an SQE on the ring of the calling worker. Otherwise
+     * the operations run on the blocking pool (see `system::offload()`), batched per loop iteration.
+     * In both cases the coroutine resumes on the worker that issued the operation.
+     *
+     * Operations report errors as negative errno values instead of throwing.
+     *
+     * @code
+     * auto f = co_await fs::File::open("/var/lib/app/snapshot", O_RDONLY);
+     * if (!f) co_return;
+     * ssize_t n = co_await f->read_at(buf, sizeof(buf), 0);
+     * @endcode
+     */
+    class File
+    {
+    public:
+        File() noexcept = default;
+
+        /// \brief Takes ownership of @p fd.
+        explicit File(int fd) noexcept : fd_(fd) {}
+
+        File(File&& o) noexcept : fd_(std::exchange(o.fd_, -1)) {}
+
+        File& operator=(File&& o) noexcept
+        {
+            if (this != &o)
+            {
+                this->close();
+                this->fd_ = std::exchange(o.fd_, -1);
+            }
+            return *this;
+        }
+
+        File(const File&) = delete;
+
+        File& operator=(const File&) = delete;
+
+        ~File() { this->close(); }
+
+        /**
+         * @brief Opens @p path asynchronously (`openat(AT_FDCWD, ...)`).
+         *
+         * `O_CLOEXEC` is always added to @p flags. Resolves to the file or to the errno of the failure.
+         */
+        [[nodiscard]] static detail::OpenAwaiter open(std::string path, int flags, mode_t mode = 0644)
+        {
+            return detail::OpenAwaiter{std::move(path), flags, mode};
+        }
+
+        /**
+         * @brief Reads up to @p len bytes at @p offset. Resolves to the bytes read (0 at end of file) or -errno.
+         *
+         * Like `pread(2)`, may read fewer bytes than requested before end of file (large requests are capped by
+         * the kernel or io_uring); loop on the result to read a full range.
+         */
+        [[nodiscard]] detail::FileOpAwaiter read_at(uint8_t* buf, size_t len, uint64_t offset) const noexcept
+        {
+            return {detail::FileOpKind::READ_AT, this->fd_, buf, len, offset};
+        }
+
+        /**
+         * @brief Writes up to @p len bytes at @p offset. Resolves to the bytes written or -errno.
+         *
+         * Like `pwrite(2)`, may write fewer bytes than requested; loop on the result to write a full range.
+         */
+        [[nodiscard]] detail::FileOpAwaiter write_at(const uint8_t* buf, size_t len, uint64_t offset) const noexcept
+        {
+            return {detail::FileOpKind::WRITE_AT, this->fd_, const_cast<uint8_t*>(buf), len, offset};
+        }
+
+        /// \brief Flushes data (and, unless @p data_only, metadata) to the device. Resolves to 0 or -errno.
+        [[nodiscard]] detail::FileOpAwaiter fsync(bool data_only = false) const noexcept
+        {
+            return {data_only ? detail::FileOpKind::FDATASYNC : detail::FileOpKind::FSYNC, this->fd_, nullptr, 0, 0};
+        }
+
+        /// \brief Closes the file synchronously. Safe to call more than once.
+        void close() noexcept;
+
+        [[nodiscard]] bool is_open() const noexcept { return this->fd_ >= 0; }
+
+        [[nodiscard]] int native_handle() const noexcept { return this->fd_; }
+
+        /// \brief Gives up ownership of the descriptor.
+        int release() noexcept { return std::exchange(this->fd_, -1); }
+
+    private:
+        int fd_{-1};
+    };
+} // namespace usub::uvent::fs
+
+#endif // UVENT_FILE_H
@@ -408,6 +408,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_accept()
         requires(p == Proto::TCP && r == Role::PASSIVE)
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
         for (;;)
         {
             sockaddr_storage ss{};
@@ -498,6 +500,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_read(utils::DynamicBuffer& buffer, size_t max_read_size)
         requires ((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
 #if UVENT_DEBUG
         spdlog::info("Entered into read coroutine: fd={}",
                      this->header_ ? this->header_->fd : -1);
@@ -642,6 +646,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_read(uint8_t* dst, size_t max_read_size)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
 #if UVENT_DEBUG
         spdlog::info("Entered into read coroutine(raw): fd={}",
                      this->header_ ? this->header_->fd : -1);
@@ -854,6 +860,8 @@ namespace usub::uvent::net
         uint8_t* buf, size_t sz)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
 #if UVENT_DEBUG
         spdlog::info("Entered into write coroutine: fd={}, sz={}", this->header_->fd, sz);
 #endif
@@ -1164,6 +1172,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_send(uint8_t* buf, size_t sz)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
         auto buf_internal = std::unique_ptr<uint8_t[]>(new uint8_t[sz]);
         std::memcpy(buf_internal.get(), buf, sz);
 
@@ -11,6 +11,7 @@
 
 #include <uvent/poll/EPoller.h>
 #include "AwaiterOperations.h"
+#include "uvent/pool/BlockingPool.h"
 #include "SocketMetadata.h"
 #include "uvent/base/Predefines.h"
 #include "uvent/system/Defines.h"
@@ -25,6 +26,237 @@ namespace usub::uvent::net
     namespace detail
     {
         extern void processSocketTimeout(std::any arg);
+
+        /**
+         * @brief Common part of the frameless socket operations.
+         *
+         * The operation is attempted in `await_ready()`, so when it can complete right away the caller
+         * does not suspend and nothing is allocated. Otherwise `await_suspend()` registers the caller
+         * for readiness, like `AwaiterRead`/`AwaiterWrite`, together with a `ReadinessRetry`: the poller
+         * runs the operation on each edge and wakes the caller only once it got past `EAGAIN`, so a
+         * spurious wakeup re-arms instead of surfacing. Each operation charges the I/O budget of the
+         * current resume; once it is spent, the operation still runs but the caller yields before
+         * getting the result.
+         *
+         * `Op` provides `bool attempt()` (true once the operation is finished), `void fail(int err)`
+         * and `result()`.
+         */
+        template <class Op, bool Write>
+        struct ReadinessAwaiter
+        {
+            SocketHeader* header{nullptr};
+            bool done{false};
+            ReadinessRetry retry{};
+
+            bool await_ready()
+            {
+                if (system::this_coroutine::consume_budget())
+                    return false;
+                return this->done = this->self()->attempt();
+            }
+
+            bool await_suspend(std::coroutine_handle<> h)
+            {
+                if (system::this_thread::detail::op_budget < 0 && (this->done = this->self()->attempt()))
+                {
+                    system::this_thread::detail::yield_ready(h);
+                    return true;
+                }
+                this->retry = {[](void* op) { return static_cast<Op*>(op)->done = static_cast<Op*>(op)->attempt(); },
+                               this->self()};
+                if constexpr (Write)
+                {
+                    this->header->second_retry = &this->retry;
+                    AwaiterWrite{this->header}.await_suspend(h);
+                }
+                else
+                {
+                    this->header->first_retry = &this->retry;
+                    AwaiterRead{this->header}.await_suspend(h);
+                }
+                return true;
+            }
+
+            decltype(auto) await_resume()
+            {
+                // not done: woken by a timeout or a hangup rather than by a completed retry
+                if (!this->done)
+                {
+                    if (this->header->socket_info & static_cast<uint8_t>(AdditionalState::TIMEOUT))
+                        this->self()->fail(ETIMEDOUT);
+                    else if (!this->self()->attempt())
+                        this->self()->fail(EAGAIN);
+                }
+                return this->self()->result();
+            }
+
+        private:
+            Op* self() { return static_cast<Op*>(this); }
+        };
+
+        /// \brief Single `recv`; yields the byte count, 0 on EOF or `-errno`.
+        struct RecvSomeAwaiter : ReadinessAwaiter<RecvSomeAwaiter, false>
+        {
+            uint8_t* buf{nullptr};
+            size_t len{0};
+            ssize_t res{0};
+
+            bool attempt()
+            {
+                ssize_t n;
+                do
+                    n = ::recv(this->header->fd, this->buf, this->len, 0);
+                while (n < 0 && errno == EINTR);
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    return false;
+                this->res = n < 0 ? -errno : n;
+#ifndef UVENT_ENABLE_REUSEADDR
+                if (n > 0)
+                    this->header->timeout_epoch_bump();
+#endif
+                return true;
+            }
+
+            void fail(int err) { this->res = -err; }
+
+            [[nodiscard]] ssize_t result() const { return this->res; }
+        };
+
+        /// \brief Single non-blocking `send`; yields the byte count (possibly partial) or `-errno`.
+        struct SendSomeAwaiter : ReadinessAwaiter<SendSomeAwaiter, true>
+        {
+            const uint8_t* buf{nullptr};
+            size_t len{0};
+            ssize_t res{0};
+
+            bool attempt()
+            {
+                ssize_t n;
+                do
+                    n = ::send(this->header->fd, this->buf, this->len, MSG_DONTWAIT);
+                while (n < 0 && errno == EINTR);
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    return false;
+                this->res = n < 0 ? -errno : n;
+#ifndef UVENT_ENABLE_REUSEADDR
+                if (n > 0)
+                    this->header->timeout_epoch_bump();
+#endif
+                return true;
+            }
+
+            void fail(int err) { this->res = -err; }
+
+            [[nodiscard]] ssize_t result() const { return this->res; }
+        };
+
+        /// \brief Single `accept4`; yields the accepted client, registered with the current thread's poller.
+        struct AcceptOneAwaiter : ReadinessAwaiter<AcceptOneAwaiter, false>
+        {
+            int cfd{-1};
+            sockaddr_storage ss{};
+
+            bool attempt()
+            {
+                for (;;)
+                {
+                    socklen_t sl = sizeof(this->ss);
+                    this->cfd = ::accept4(this->header->fd, reinterpret_cast<sockaddr*>(&this->ss), &sl,
+                                          SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (this->cfd >= 0)
+                        return true;
+                    switch (errno)
+                    {
+                    case EINTR:
+                    case ECONNABORTED:
+                    case EPROTO:
+                        continue;
+                    // out of descriptors or memory: wait for the next connection like async_accept() does
+                    case EAGAIN:
+                    case ENOBUFS:
+                    case ENOMEM:
+                    case ENFILE:
+                    case EMFILE:
+                        return false;
+                    default:
+                        return true;
+                    }
+                }
+            }
+
+            void fail(int) { this->cfd = -1; }
+
+            std::optional<TCPClientSocket> result();
+        };
+
+        /// \brief Non-blocking `connect` of a fresh socket; yields `std::nullopt` on success, `AlreadyConnected` when
+        /// the socket already has a descriptor.
+        struct ConnectToAwaiter : ReadinessAwaiter<ConnectToAwaiter, true>
+        {
+            const sockaddr* addr{nullptr};
+            socklen_t addr_len{0};
+            bool started{false};
+            std::optional<usub::utils::errors::ConnectError> res;
+
+            bool attempt()
+            {
+                if (this->started)
+                    return this->check();
+                this->started = true;
+                if (this->header->fd != INVALID_FD)
+                {
+                    this->res = usub::utils::errors::ConnectError::AlreadyConnected;
+                    return true;
+                }
+                this->header->fd = ::socket(this->addr->sa_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                if (this->header->fd < 0)
+                {
+                    this->res = usub::utils::errors::ConnectError::SocketCreationFailed;
+                    return true;
+                }
+                if (::connect(this->header->fd, this->addr, this->addr_len) < 0 && errno != EINPROGRESS)
+                {
+                    this->fail(ECONNREFUSED);
+                    return true;
+                }
+                system::this_thread::detail::pl.addEvent(this->header, core::OperationType::ALL);
+                return false;
+            }
+
+            bool check()
+            {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                if (this->header->socket_info & static_cast<uint8_t>(AdditionalState::CONNECTION_FAILED) ||
+                    ::getsockopt(this->header->fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0)
+                    err = ECONNREFUSED;
+                if (err == EINPROGRESS || err == EALREADY)
+                    return false;
+                if (err != 0)
+                {
+                    this->fail(err);
+                    return true;
+                }
+                this->res = std::nullopt;
+#ifndef UVENT_ENABLE_REUSEADDR
+                this->header->timeout_epoch_bump();
+#endif
+                return true;
+            }
+
+            void fail(int err)
+            {
+                if (this->header->fd >= 0)
+                {
+                    ::close(this->header->fd);
+                    this->header->fd = -1;
+                }
+                this->res = err == ETIMEDOUT ? usub::utils::errors::ConnectError::Timeout
+                                             : usub::utils::errors::ConnectError::ConnectFailed;
+            }
+
+            [[nodiscard]] std::optional<usub::utils::errors::ConnectError> result() const { return this->res; }
+        };
     }
 
     template <Proto p, Role r>
@@ -138,6 +370,40 @@ namespace usub::uvent::net
                                                                                                      size_t sz)
             requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP));
 
+        /**
+         * \brief Accepts one connection without allocating a coroutine frame.
+         * Same result as async_accept(), but returns a plain awaiter: if a connection is already
+         * pending, `co_await` completes without suspending.
+         */
+        [[nodiscard]] detail::AcceptOneAwaiter async_accept_one()
+            requires(p == Proto::TCP && r == Role::PASSIVE);
+
+        /**
+         * \brief Performs a single recv into dst without allocating a coroutine frame.
+         * Completes without suspending when data is already buffered, otherwise waits for EPOLLIN.
+         * Yields the number of bytes read, 0 on EOF, or a negative errno (-ETIMEDOUT after a socket
+         * timeout, -EAGAIN only when woken by a hangup with no data pending).
+         */
+        [[nodiscard]] detail::RecvSomeAwaiter async_read_some(uint8_t* dst, size_t max_read_size)
+            requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP));
+
+        /**
+         * \brief Performs a single send from buf without allocating a coroutine frame.
+         * Completes without suspending when the socket has buffer space, otherwise waits for EPOLLOUT.
+         * Yields the number of bytes written, which may be less than sz, or a negative errno.
+         */
+        [[nodiscard]] detail::SendSomeAwaiter async_write_some(const uint8_t* buf, size_t sz)
+            requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP));
+
+        /**
+         * \brief Connects to an already resolved address without allocating a coroutine frame.
+         * Creates the underlying socket and registers it with the current thread's poller. A socket that
+         * already has a descriptor is left untouched and yields `ConnectError::AlreadyConnected`.
+         * \warning addr must stay valid until the `co_await` completes.
+         */
+        [[nodiscard]] detail::ConnectToAwaiter async_connect_to(const sockaddr* addr, socklen_t addr_len)
+            requires(p == Proto::TCP && r == Role::ACTIVE);
+
         /**
          * \brief Synchronously reads data into the buffer.
          * Performs a blocking read up to max_read_size bytes.
@@ -395,6 +661,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_accept()
         requires(p == Proto::TCP && r == Role::PASSIVE)
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
         for (;;)
         {
             sockaddr_storage ss{};
@@ -463,6 +731,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_read(utils::DynamicBuffer& buffer, size_t max_read_size)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
         if (max_read_size == 0)
             co_return 0;
 
@@ -592,6 +862,8 @@ namespace usub::uvent::net
                                                                                                 size_t max_read_size)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
         if (!dst || max_read_size == 0)
             co_return 0;
 
@@ -715,6 +987,8 @@ namespace usub::uvent::net
                                                                                                  size_t sz)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
 #if UVENT_DEBUG
         spdlog::info("Entered into write coroutine: fd={}, sz={}", this->header_->fd, sz);
 #endif
@@ -799,6 +1073,61 @@ namespace usub::uvent::net
         }
     }
 
+    inline std::optional<TCPClientSocket> detail::AcceptOneAwaiter::result()
+    {
+        if (this->cfd < 0)
+            return std::nullopt;
+        auto* h = new SocketHeader{.fd = this->cfd,
+                                   .socket_info = uint8_t(Proto::TCP) | uint8_t(Role::ACTIVE),
+                                   .state = (1ull & usub::utils::sync::refc::COUNT_MASK)};
+        system::this_thread::detail::pl.addEvent(h, core::OperationType::READ);
+
+        TCPClientSocket sc(h);
+        if (this->ss.ss_family == AF_INET)
+            sc.address = *reinterpret_cast<sockaddr_in*>(&this->ss);
+        else if (this->ss.ss_family == AF_INET6)
+        {
+            sc.address = *reinterpret_cast<sockaddr_in6*>(&this->ss);
+            sc.ipv = utils::net::IPV6;
+        }
+        return sc;
+    }
+
+    template <Proto p, Role r>
+    detail::AcceptOneAwaiter Socket<p, r>::async_accept_one()
+        requires(p == Proto::TCP && r == Role::PASSIVE)
+    {
+        return detail::AcceptOneAwaiter{{this->header_}};
+    }
+
+    template <Proto p, Role r>
+    detail::RecvSomeAwaiter Socket<p, r>::async_read_some(uint8_t* dst, size_t max_read_size)
+        requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
+    {
+        return detail::RecvSomeAwaiter{{this->header_}, dst, max_read_size};
+    }
+
+    template <Proto p, Role r>
+    detail::SendSomeAwaiter Socket<p, r>::async_write_some(const uint8_t* buf, size_t sz)
+        requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
+    {
+        return detail::SendSomeAwaiter{{this->header_}, buf, sz};
+    }
+
+    template <Proto p, Role r>
+    detail::ConnectToAwaiter Socket<p, r>::async_connect_to(const sockaddr* addr, socklen_t addr_len)
+        requires(p == Proto::TCP && r == Role::ACTIVE)
+    {
+        if (addr->sa_family == AF_INET6)
+        {
+            this->address = *reinterpret_cast<const sockaddr_in6*>(addr);
+            this->ipv = utils::net::IPV6;
+        }
+        else
+            this->address = *reinterpret_cast<const sockaddr_in*>(addr);
+        return detail::ConnectToAwaiter{{this->header_}, addr, addr_len};
+    }
+
     template <Proto p, Role r>
     ssize_t Socket<p, r>::read(utils::DynamicBuffer& buffer, size_t max_read_size)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
@@ -904,7 +1233,18 @@ namespace usub::uvent::net
         hints.ai_socktype = SOCK_STREAM;
         hints.ai_protocol = 0;
 
-        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0 || !res)
+        // numeric addresses resolve without I/O; a DNS lookup may block, so it runs on the blocking pool
+        hints.ai_flags = AI_NUMERICHOST;
+        int gai = getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
+        if (gai == EAI_NONAME)
+        {
+            // the caller's strings need not outlive the first suspension of this eagerly started frame
+            const std::string host_copy(host), port_copy(port);
+            hints.ai_flags = 0;
+            auto resolve = [&] { return getaddrinfo(host_copy.c_str(), port_copy.c_str(), &hints, &res); };
+            gai = co_await system::offload(resolve);
+        }
+        if (gai != 0 || !res)
         {
             this->header_->fd = -1;
             co_return usub::utils::errors::ConnectError::GetAddrInfoFailed;
@@ -993,7 +1333,18 @@ namespace usub::uvent::net
         hints.ai_socktype = SOCK_STREAM;
         hints.ai_protocol = 0;
 
-        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0 || !res)
+        // numeric addresses resolve without I/O; a DNS lookup may block, so it runs on the blocking pool
+        hints.ai_flags = AI_NUMERICHOST;
+        int gai = getaddrinfo(host.c_str(), port.c_str(), &hints, &res);
+        if (gai == EAI_NONAME)
+        {
+            // the caller's strings need not outlive the first suspension of this eagerly started frame
+            const std::string host_copy(host), port_copy(port);
+            hints.ai_flags = 0;
+            auto resolve = [&] { return getaddrinfo(host_copy.c_str(), port_copy.c_str(), &hints, &res); };
+            gai = co_await system::offload(resolve);
+        }
+        if (gai != 0 || !res)
         {
             this->header_->fd = -1;
             co_return usub::utils::errors::ConnectError::GetAddrInfoFailed;
@@ -1077,6 +1428,8 @@ namespace usub::uvent::net
     Socket<p, r>::async_send(uint8_t* buf, size_t sz)
         requires((p == Proto::TCP && r == Role::ACTIVE) || (p == Proto::UDP))
     {
+        if (system::this_coroutine::consume_budget())
+            co_await system::this_coroutine::yield();
         auto buf_internal = std::unique_ptr<uint8_t[]>(new uint8_t[sz]);
         std::memcpy(buf_internal.get(), buf, sz);
 
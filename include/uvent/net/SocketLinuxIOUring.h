@@ -56,6 +56,7 @@ namespace usub::uvent::net
                 op.kind = IoOpKind::Recv;
                 op.header = header;
                 op.coro = h;
+                op.priority = system::this_thread::detail::cur_priority;
                 op.buf = buf;
                 op.len = len;
 
@@ -86,6 +87,7 @@ namespace usub::uvent::net
                 op.kind = IoOpKind::Send;
                 op.header = header;
                 op.coro = h;
+                op.priority = system::this_thread::detail::cur_priority;
                 op.buf = buf;
                 op.len = len;
 
@@ -114,6 +116,7 @@ namespace usub::uvent::net
                 op.kind = IoOpKind::Accept;
                 op.header = header;
                 op.coro = h;
+                op.priority = system::this_thread::detail::cur_priority;
                 op.addrlen = sizeof(op.addr);
 
                 auto& pl = static_cast<IOUringPoller&>(system::this_thread::detail::pl);
@@ -141,8 +144,9 @@ namespace usub::uvent::net
                 op.kind = IoOpKind::SendFile;
                 op.header = header;
                 op.coro = h;
+                op.priority = system::this_thread::detail::cur_priority;
 
-                system::this_thread::detail::q->enqueue(h);
+                system::this_thread::detail::enqueue_ready(h, op.priority);
             }
 
             void await_resume() noexcept
@@ -163,6 +167,7 @@ namespace usub::uvent::net
                 op.kind = IoOpKind::Connect;
                 op.header = header;
                 op.coro = h;
+                op.priority = system::this_thread::detail::cur_priority;
 
                 auto& pl = static_cast<IOUringPoller&>(system::this_thread::detail::pl);
                 pl.submit_connect(&op, header->fd);
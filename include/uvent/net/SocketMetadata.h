@@ -14,6 +14,7 @@
 
 #include "uvent/base/Predefines.h"
 #include "uvent/system/Defines.h"
+#include "uvent/tasks/Priority.h"
 #include "uvent/utils/sync/RefCountedSession.h"
 #include "uvent/utils/intrinsincs/optimizations.h"
 
@@ -28,16 +29,35 @@ namespace usub::uvent::net
         CONNECTION_PENDING = 1 << 4, CONNECTION_FAILED = 1 << 5, DISCONNECTED = 1 << 6, TIMEOUT = 1 << 7
     };
 
+    /**
+     * @brief Operation of a frameless readiness waiter, retried by the poller before the waiter is woken.
+     *
+     * `attempt(op)` returns false while the operation would still block; the waiter then stays armed for the
+     * next edge instead of resuming to an `EAGAIN`.
+     */
+    struct ReadinessRetry
+    {
+        bool (*attempt)(void* op){nullptr};
+        void* op{nullptr};
+    };
+
     struct alignas(32) SocketHeader
     {
         socket_fd_t fd{INVALID_FD};
         uint64_t timer_id{0};
-        uint8_t socket_info;
-        std::coroutine_handle<> first, second;
+        uint8_t socket_info{0};
+        /// \brief Classes of the coroutines waiting in `first` and `second`, recorded when they suspended.
+        task::Priority first_priority{task::Priority::NORMAL}, second_priority{task::Priority::NORMAL};
+        /// \brief Worker whose load counts this socket while it is registered with a poller, -1 otherwise.
+        /// Atomic: the socket may be unregistered from a thread other than the one that counted it.
+        std::atomic<int32_t> counted_tid{-1};
+        std::coroutine_handle<> first{nullptr}, second{nullptr};
+        /// \brief Retries of frameless waiters in `first` and `second`, cleared whenever those are taken.
+        ReadinessRetry *first_retry{nullptr}, *second_retry{nullptr};
 #ifndef UVENT_ENABLE_REUSEADDR
-        std::atomic<uint64_t> state;
+        std::atomic<uint64_t> state{0};
 #else
-        uint64_t state;
+        uint64_t state{0};
 #endif
 
 #if UVENT_DEBUG
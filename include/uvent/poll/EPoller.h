@@ -24,7 +24,7 @@ namespace usub::uvent::core
     public:
         explicit EPoller(utils::TimerWheel& wheel);
 
-        ~EPoller() = default;
+        ~EPoller();
 
         void addEvent(net::SocketHeader* header, OperationType initialState);
 
@@ -44,9 +44,14 @@ namespace usub::uvent::core
 
         int get_poll_fd();
 
+        /// \brief Interrupts a blocking `poll()` of the owning thread. Safe to call from any thread.
+        void wakeup();
+
     private:
         std::binary_semaphore lock{1};
         int poll_fd{-1};
+        /// @brief eventfd registered in poll_fd, written by `wakeup()`
+        int wake_fd{-1};
         uint64_t timeoutDuration_ms{5000};
         std::atomic_bool is_locked{false};
 
@@ -24,7 +24,12 @@ namespace usub::uvent::core
             Send,
             Accept,
             SendFile,
-            Connect
+            Connect,
+            Wakeup,
+            ReadAt,
+            WriteAt,
+            Fsync,
+            OpenAt
         };
 
         struct IoOpBase
@@ -32,6 +37,8 @@ namespace usub::uvent::core
             IoOpKind kind{};
             net::SocketHeader* header{nullptr};
             std::coroutine_handle<> coro{};
+            /// \brief Class `coro` is resumed in, recorded when it suspended.
+            task::Priority priority{task::Priority::NORMAL};
             ssize_t res{0};
             int err{0};
             bool completed{false};
@@ -70,6 +77,20 @@ namespace usub::uvent::core
             sockaddr_storage addr{};
             socklen_t addrlen{0};
         };
+
+        /// \brief Positional read/write, fsync or openat on a file; `kind` selects which fields are used.
+        struct FileOp : IoOpBase
+        {
+            int fd{-1};
+            void* buf{nullptr};
+            size_t len{0};
+            uint64_t offset{0};
+            /// \brief `IORING_FSYNC_DATASYNC` or 0.
+            unsigned fsync_flags{0};
+            const char* path{nullptr};
+            int open_flags{0};
+            mode_t mode{0};
+        };
     } // namespace detail
 
     class IOUringPoller
@@ -93,12 +114,25 @@ namespace usub::uvent::core
         void submit_accept(detail::AcceptOp* op, int fd);
         void submit_sendfile(detail::SendFileOp* op, int out_fd);
         void submit_connect(detail::ConnectOp* op, int fd);
+        /**
+         * @brief Queues a file operation.
+         *
+         * Like the socket operations it is only prepared here; everything queued during a loop
+         * iteration reaches the kernel with the single `io_uring_submit()` of the next `poll()`.
+         */
+        void submit_file(detail::FileOp* op);
 
         void deregisterEvent(net::SocketHeader* header) const;
 
+        /// \brief Interrupts a blocking `poll()` of the owning thread. Safe to call from any thread.
+        void wakeup();
+
     private:
         void handle_cqe(struct io_uring_cqe* cqe);
 
+        /// \brief (Re)arms the read of the wakeup eventfd; retried before the next wait if the SQ has no room.
+        void arm_wakeup();
+
     private:
         utils::TimerWheel& wheel;
 
@@ -109,6 +143,13 @@ namespace usub::uvent::core
         unsigned int ring_entries{1024};
 
         sigset_t sigmask{};
+
+        /// \brief eventfd written by `wakeup()`; a pending read of it completes the wait.
+        int wake_fd{-1};
+        uint64_t wake_value{0};
+        detail::IoOpBase wake_op{};
+        /// \brief A read of `wake_fd` is queued or in flight.
+        bool wake_armed{false};
     };
 } // namespace usub::uvent::core
 
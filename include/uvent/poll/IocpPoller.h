@@ -47,6 +47,9 @@ namespace usub::uvent::core
 
         void lock_poll(int timeout_ms);
 
+        /// \brief Interrupts a blocking `poll()` of the owning thread. Safe to call from any thread.
+        void wakeup();
+
     private:
         std::binary_semaphore lock{1};
         std::atomic_bool is_locked{false};
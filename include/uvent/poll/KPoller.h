@@ -27,7 +27,7 @@ namespace usub::uvent::core
     public:
         explicit KQueuePoller(utils::TimerWheel& wheel);
 
-        ~KQueuePoller() = default;
+        ~KQueuePoller();
 
         void addEvent(net::SocketHeader* header, OperationType initialState);
 
@@ -45,6 +45,9 @@ namespace usub::uvent::core
 
         int get_poll_fd() const;
 
+        /// \brief Interrupts a blocking `poll()` of the owning thread. Safe to call from any thread.
+        void wakeup();
+
         void deregisterEvent(net::SocketHeader* header) const;
     private:
         inline void enable_read(net::SocketHeader* h, bool enable, bool clear_edge) const
@@ -68,6 +71,8 @@ namespace usub::uvent::core
         }
 
     private:
+        static constexpr uintptr_t WAKEUP_IDENT = 1;
+
         std::binary_semaphore lock{1};
         int poll_fd{-1};
         uint64_t timeoutDuration_ms{5000};
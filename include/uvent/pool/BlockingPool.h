@@ -0,0 +1,179 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_BLOCKINGPOOL_H
+#define UVENT_BLOCKINGPOOL_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "uvent/system/SystemContext.h"
+
+namespace usub::uvent
+{
+    /// \brief Queue-depth and throughput counters of the blocking pool, see `system::offload_stats()`.
+    struct BlockingPoolStats
+    {
+        /// \brief Threads started so far (0 until the first offload).
+        int threads{0};
+        /// \brief Jobs waiting for a thread.
+        size_t queue_depth{0};
+        /// \brief Highest queue depth observed.
+        size_t max_queue_depth{0};
+        /// \brief Jobs currently running.
+        size_t running{0};
+        uint64_t submitted{0};
+        uint64_t completed{0};
+    };
+
+    /**
+     * @brief Threads for blocking or CPU-heavy work, separate from the event-loop workers.
+     *
+     * The pool is process-wide and sized by `settings::blocking_pool_threads`, independently of the
+     * number of `Uvent` workers. Its threads are started on the first submission and joined at exit.
+     */
+    class BlockingPool
+    {
+    public:
+        struct Job
+        {
+            void (*fn)(void*);
+            void* arg;
+        };
+
+        static BlockingPool& instance();
+
+        void submit(Job job);
+
+        [[nodiscard]] BlockingPoolStats stats() const;
+
+        BlockingPool(const BlockingPool&) = delete;
+
+        BlockingPool& operator=(const BlockingPool&) = delete;
+
+    private:
+        BlockingPool() = default;
+
+        void worker(std::stop_token token);
+
+        mutable std::mutex mtx_;
+        std::condition_variable_any cv_;
+        std::deque<Job> jobs_;
+        size_t running_{0};
+        size_t max_depth_{0};
+        uint64_t submitted_{0};
+        uint64_t completed_{0};
+        // declared last: threads are stopped and joined before the queue they wait on is destroyed
+        std::vector<std::jthread> threads_;
+    };
+
+    namespace detail
+    {
+        /**
+         * \brief Called from a pool thread: resumes @p h in class @p priority on worker @p t_id,
+         *        or on any worker if it no longer exists.
+         */
+        inline void resume_on(WakeHandle h, int t_id, task::Priority priority)
+        {
+            const auto frame = h.to_frame(priority);
+            if (t_id >= 0 && t_id < system::global::detail::thread_count.load(std::memory_order_acquire))
+                system::co_spawn_static(frame, t_id);
+            else
+                system::co_spawn(frame);
+        }
+
+        template <class F>
+        class OffloadAwaiter
+        {
+            using result_t = std::invoke_result_t<F&>;
+            static_assert(!std::is_reference_v<result_t>, "offload() cannot return a reference");
+
+        public:
+            explicit OffloadAwaiter(F fn) : fn_(std::move(fn)) {}
+
+            OffloadAwaiter(const OffloadAwaiter&) = delete;
+
+            OffloadAwaiter& operator=(const OffloadAwaiter&) = delete;
+
+            bool await_ready() const noexcept { return false; }
+
+            template <class P>
+            void await_suspend(std::coroutine_handle<P> h)
+            {
+                this->h_ = h;
+                this->t_id_ = system::this_thread::detail::t_id;
+                this->priority_ = system::this_thread::detail::cur_priority;
+                BlockingPool::instance().submit({&OffloadAwaiter::run, this});
+            }
+
+            result_t await_resume()
+            {
+                if (this->exception_)
+                    std::rethrow_exception(this->exception_);
+                if constexpr (!std::is_void_v<result_t>)
+                    return std::move(*this->result_);
+            }
+
+        private:
+            static void run(void* arg)
+            {
+                auto* self = static_cast<OffloadAwaiter*>(arg);
+                try
+                {
+                    if constexpr (std::is_void_v<result_t>)
+                        std::invoke(self->fn_);
+                    else
+                        self->result_.emplace(std::invoke(self->fn_));
+                }
+                catch (...)
+                {
+                    self->exception_ = std::current_exception();
+                }
+                // the awaiter lives in the suspended frame: it may be gone as soon as the coroutine is queued
+                resume_on(self->h_, self->t_id_, self->priority_);
+            }
+
+            F fn_;
+            WakeHandle h_{};
+            int t_id_{-1};
+            task::Priority priority_{task::Priority::NORMAL};
+            std::exception_ptr exception_{nullptr};
+            std::conditional_t<std::is_void_v<result_t>, bool, std::optional<result_t>> result_{};
+        };
+    } // namespace detail
+
+    namespace system
+    {
+        /**
+         * @brief Runs @p fn on the blocking pool and resumes the caller on its own worker with the result.
+         *
+         * The calling worker keeps running other coroutines meanwhile. Exceptions thrown by @p fn are
+         * rethrown from the `co_await`. Use it for calls that would stall the event loop: DNS lookups,
+         * file system access, compression, password hashing.
+         *
+         * @code
+         * auto digest = co_await system::offload([&] { return hash_password(pw); });
+         * @endcode
+         */
+        template <class F>
+        [[nodiscard]] uvent::detail::OffloadAwaiter<std::decay_t<F>> offload(F&& fn)
+        {
+            return uvent::detail::OffloadAwaiter<std::decay_t<F>>{std::forward<F>(fn)};
+        }
+
+        /// \brief Snapshot of the blocking pool counters.
+        inline BlockingPoolStats offload_stats() { return BlockingPool::instance().stats(); }
+    } // namespace system
+} // namespace usub::uvent
+
+#endif // UVENT_BLOCKINGPOOL_H
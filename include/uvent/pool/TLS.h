@@ -8,20 +8,227 @@
 #include <atomic>
 #include <coroutine>
 #include <uvent/base/Predefines.h>
+#include <uvent/poll/PollerBase.h>
+#include <uvent/tasks/AwaitableFrame.h>
 #include <uvent/utils/datastructures/queue/ConcurrentQueues.h>
 #include <uvent/utils/datastructures/queue/FastQueue.h>
+#include <uvent/utils/datastructures/queue/IntrusiveMPSCQueue.h>
 
 namespace usub::uvent::thread
 {
+    /**
+     * @brief Snapshot of a worker's idle-policy counters.
+     *
+     * Times are cumulative nanoseconds spent in each idle phase; `*_hits` count idle episodes that
+     * found work during that phase, `parks` counts episodes that blocked in the poller.
+     */
+    struct IdleStats
+    {
+        uint64_t spin_ns{0};
+        uint64_t yield_ns{0};
+        uint64_t park_ns{0};
+        uint64_t spin_hits{0};
+        uint64_t yield_hits{0};
+        uint64_t parks{0};
+    };
+
+    /**
+     * @brief Snapshot of a worker's runtime counters.
+     *
+     * Counters are cumulative since the worker started and are published by the worker once per loop
+     * iteration, so a snapshot may lag by one iteration. Queue depths are approximate.
+     */
+    struct ThreadStats
+    {
+        /// \brief Coroutines resumed by the worker loop.
+        uint64_t resumed{0};
+        /// \brief Calls into the poller, blocking or not.
+        uint64_t polls{0};
+        /// \brief Coroutines made runnable by the poller; `poll_events / polls` is the mean batch size.
+        uint64_t poll_events{0};
+        /// \brief Polls that made nothing runnable.
+        uint64_t empty_polls{0};
+        uint64_t timers_fired{0};
+        /// \brief Completed coroutine frames destroyed by the worker.
+        uint64_t destroyed{0};
+        /// \brief Thread-local run queue (published once per iteration).
+        uint64_t run_queue_depth{0};
+        /// \brief Stealable run queue.
+        uint64_t local_queue_depth{0};
+        /// \brief Tasks waiting in the inbox.
+        uint64_t inbox_depth{0};
+        /// \brief Non-listening sockets registered with the worker's poller.
+        uint64_t live_sockets{0};
+        /// \brief Global queue shared by all workers.
+        uint64_t global_queue_depth{0};
+        /// \brief Time since the worker started.
+        uint64_t uptime_ns{0};
+        /// \brief Time blocked in the poller (`idle.park_ns`).
+        uint64_t blocked_ns{0};
+        /// \brief Time neither blocked nor spinning/yielding for work.
+        uint64_t running_ns{0};
+        IdleStats idle;
+    };
+
     struct alignas(data_structures::metadata::CACHELINE_SIZE) ThreadLocalStorage
     {
         friend class system::Thread;
+        friend class uvent::ThreadPool;
+
+        explicit ThreadLocalStorage(int numa_node = -1);
 
+        /**
+         * @brief Pushes a runtime frame into the inbox of the thread owning this storage.
+         *
+         * The inbox is an unbounded intrusive MPSC queue linked through the coroutine frames: the push
+         * is wait-free, never allocates and never drops the task. @p task must be in no other inbox.
+         */
+        void push_task_inbox(std::coroutine_handle<uvent::detail::AwaitableFrameBase> task);
+
+        /**
+         * @brief Pushes any coroutine into the inbox.
+         *
+         * A bare handle cannot be linked through its frame: it is wrapped in a pooled runtime frame
+         * first, see `uvent::detail::wrap_foreign()`.
+         */
         void push_task_inbox(std::coroutine_handle<> task);
 
+        /// \brief Pushes @p n runtime frames into the inbox with a single exchange and a single doorbell.
+        void push_tasks_inbox(const std::coroutine_handle<uvent::detail::AwaitableFrameBase>* tasks, size_t n);
+
+        /// \brief Pushes @p n coroutines of any kind, each wrapped like by `push_task_inbox(std::coroutine_handle<>)`.
+        void push_tasks_inbox(const std::coroutine_handle<>* tasks, size_t n);
+
+        /**
+         * @brief Pushes a task into the inbox only if fewer than `INBOX_SOFT_CAPACITY` tasks are waiting in it.
+         *
+         * @return false if the inbox is that deep (backpressure); the task is not enqueued.
+         */
+        [[nodiscard]] bool try_push_task_inbox(std::coroutine_handle<uvent::detail::AwaitableFrameBase> task);
+
+        /// \brief Inbox depth above which `try_push_task_inbox()` refuses new tasks.
+        static constexpr uint64_t INBOX_SOFT_CAPACITY = 1024;
+
+        /**
+         * @brief Pushes a task into the owner's stealable run queue.
+         *
+         * Must be called only from the thread owning this storage.
+         *
+         * @return false if the run queue is full; the caller has to place the task elsewhere.
+         */
+        bool push_task_local(std::coroutine_handle<> task);
+
+        /**
+         * @brief Pushes up to @p n tasks into the owner's stealable run queue with a single publication.
+         *
+         * Must be called only from the thread owning this storage.
+         *
+         * @return Number of tasks pushed, from the front of @p tasks; the caller places the rest elsewhere.
+         */
+        size_t push_tasks_local(const std::coroutine_handle<>* tasks, size_t n);
+
+        /**
+         * @brief Steals roughly half of the stealable run queue.
+         *
+         * Safe to call from any thread.
+         *
+         * @return Number of handles written to @p out.
+         */
+        size_t steal_tasks(std::coroutine_handle<>* out, size_t max_items);
+
+        /// \brief Approximate number of tasks waiting in the stealable run queue.
+        [[nodiscard]] size_t local_tasks_size() const noexcept;
+
+        /// \brief Idle-policy counters of the owning thread. Safe to call from any thread.
+        [[nodiscard]] IdleStats idle_stats() const noexcept;
+
+        /// \brief Runtime counters of the owning thread. Safe to call from any thread.
+        [[nodiscard]] ThreadStats stats() const;
+
+        /**
+         * @brief Load estimate used by `system::co_spawn_balanced()`. Safe to call from any thread.
+         *
+         * Sum of the published run-queue depth, the stealable run queue, the inbox and the live sockets.
+         * Counting the inbox makes tasks placed since the owner's last iteration visible immediately.
+         */
+        [[nodiscard]] uint64_t load() const noexcept;
+
+        /**
+         * @brief Counts @p header as a live socket of the calling worker.
+         *
+         * Called by the pollers when a socket is registered. Listening sockets and calls outside the
+         * thread pool are ignored; a header is counted at most once.
+         */
+        static void socket_registered(net::SocketHeader* header) noexcept;
+
+        /// \brief Stops counting @p header, on whichever worker it was counted. Idempotent.
+        static void socket_unregistered(net::SocketHeader* header) noexcept;
+
+        /**
+         * @brief True if the owning thread has been retired by `Uvent::resize()`.
+         *
+         * A retired thread keeps serving the sockets, timers and inbox it already owns, but takes no
+         * shared work: it neither steals nor pulls from the global queue, and its spawns go to the global queue.
+         */
+        [[nodiscard]] bool retired() const noexcept { return this->retired_.load(std::memory_order_relaxed); }
+
+        /// \brief NUMA node the owning thread is placed on, -1 if unknown.
+        [[nodiscard]] int numa_node() const noexcept { return this->numa_node_; }
+
+        /**
+         * @brief Rings the owner's doorbell if it is parked in its poller.
+         *
+         * Safe to call from any thread. Costs a single load when the owner is running,
+         * and at most one wakeup per park when several producers race.
+         *
+         * @return true if the owner was parked and has been woken up.
+         */
+        bool wake_if_parked();
+
     private:
-        queue::concurrent::MPMCQueue<std::coroutine_handle<>> inbox_q_;
+        [[nodiscard]] uint64_t inbox_depth() const noexcept;
+
+        void push_chain_inbox(uvent::detail::AwaitableFrameBase* first, uvent::detail::AwaitableFrameBase* last,
+                              size_t count);
+
+        /// \brief Tasks pushed so far; with `inbox_popped_` it gives the inbox depth.
+        alignas(data_structures::metadata::CACHELINE_SIZE) std::atomic<uint64_t> inbox_pushed_{0};
+        queue::concurrent::IntrusiveMPSCQueue<uvent::detail::AwaitableFrameBase> inbox_q_;
+        /// \brief Tasks taken out of the inbox so far, published by the owner once per drain.
+        std::atomic<uint64_t> inbox_popped_{0};
+        queue::concurrent::WorkStealingQueue<std::coroutine_handle<>> local_q_;
         std::atomic_bool is_added_new_{false};
+        /// \brief Poller of the owning thread, set when the thread starts.
+        core::PollerImpl* poller_{nullptr};
+        /// \brief True while the owning thread is (about to be) blocked in its poller.
+        std::atomic_bool parked_{false};
+        int numa_node_{-1};
+        std::atomic_bool retired_{false};
+        /// \brief Sockets registered from this thread; may be updated by the thread that closes them.
+        std::atomic<int64_t> live_sockets_{0};
+
+        struct
+        {
+            std::atomic<uint64_t> spin_ns{0};
+            std::atomic<uint64_t> yield_ns{0};
+            std::atomic<uint64_t> park_ns{0};
+            std::atomic<uint64_t> spin_hits{0};
+            std::atomic<uint64_t> yield_hits{0};
+            std::atomic<uint64_t> parks{0};
+        } idle_stats_;
+
+        /// \brief Written by the owner only, once per loop iteration.
+        struct
+        {
+            std::atomic<uint64_t> resumed{0};
+            std::atomic<uint64_t> polls{0};
+            std::atomic<uint64_t> poll_events{0};
+            std::atomic<uint64_t> empty_polls{0};
+            std::atomic<uint64_t> timers_fired{0};
+            std::atomic<uint64_t> destroyed{0};
+            std::atomic<uint64_t> run_queue_depth{0};
+            std::atomic<int64_t> started_ns{0};
+        } stats_;
     };
 } // namespace usub::uvent::thread
 
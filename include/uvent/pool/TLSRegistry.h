@@ -6,6 +6,7 @@
 #define TLSREGISTRY_H
 
 #include <uvent/pool/TLS.h>
+#include <uvent/system/Topology.h>
 #include <uvent/utils/datastructures/array/ConcurrentVector.h>
 
 namespace usub::uvent::thread
@@ -17,8 +18,27 @@ namespace usub::uvent::thread
 
         explicit TLSRegistry(int threadCount);
 
+        /**
+         * @brief Allocates the storage of every worker on the NUMA node of its slot.
+         *
+         * Each storage is constructed while the calling thread is temporarily bound to the CPUs of
+         * that worker, so its queues are first touched node-locally.
+         */
+        explicit TLSRegistry(const std::vector<system::topology::WorkerSlot>& slots);
+
         [[nodiscard]] ThreadLocalStorage* getStorage(int index) const;
 
+        /**
+         * @brief Appends the storage of a thread added at runtime.
+         *
+         * Existing storages keep their addresses; concurrent `getStorage()` calls stay valid.
+         *
+         * @return Index of the new storage.
+         */
+        int addStorage(int numa_node = -1);
+
+        [[nodiscard]] int size() const noexcept;
+
     private:
         array::concurrent::LockFreeVector<ThreadLocalStorage*> tls_storage_;
     };
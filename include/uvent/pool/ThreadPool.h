@@ -6,9 +6,11 @@
 #define UVENT_THREADPOOL_H
 
 #include <cmath>
+#include <mutex>
 #include <uvent/system/Thread.h>
 #include <uvent/system/Defines.h>
 #include <uvent/system/SystemContext.h>
+#include <uvent/system/Topology.h>
 
 namespace usub::uvent
 {
@@ -17,7 +19,7 @@ namespace usub::uvent
     public:
         friend class Uvent;
 
-        explicit ThreadPool(int size);
+        explicit ThreadPool(int size, const system::ThreadPlacement& placement = system::ThreadPlacement::from_build());
 
         ~ThreadPool();
 
@@ -25,12 +27,51 @@ namespace usub::uvent
 
         void addThread(system::ThreadLaunchMode tlm);
 
+        /**
+         * @brief Runs one loop iteration of the worker that `addThread(CURRENT)` would run.
+         *
+         * The worker is created and bound to the calling thread on the first call; every later call
+         * must come from that same thread. See `system::Thread::poll_once()`.
+         */
+        size_t pollOnce(int timeout_ms);
+
+        /// \brief True once `stop()` has been called.
+        [[nodiscard]] bool stopped() const noexcept { return this->stopped_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Changes the number of active workers.
+         *
+         * Growing reactivates retired workers first, then starts new threads. Shrinking retires the
+         * highest-index active workers; see `ThreadLocalStorage::retired()`. Safe to call from any thread,
+         * including a worker.
+         */
+        void resize(int active);
+
+        /// \brief Number of workers that are not retired.
+        [[nodiscard]] int activeThreads() const;
+
         const thread::TLSRegistry* getTLSRegistry();
 
+        /// \brief CPUs and NUMA node of every worker started so far, indexed by thread.
+        [[nodiscard]] std::vector<system::topology::WorkerSlot> workerSlots() const;
+
     private:
         int size_;
         std::barrier<>* barrier;
         std::vector<system::Thread*> threads;
+        std::vector<system::topology::WorkerSlot> slots_;
+        system::ThreadPlacement placement_;
+        mutable std::mutex threads_mtx_;
+        /// \brief True if the workers span several NUMA nodes and their memory is allocated node-locally.
+        bool node_local_{false};
+        /// \brief Worker driven by `pollOnce()`, nullptr until its first call.
+        system::Thread* polled_{nullptr};
+        std::atomic_bool stopped_{false};
+
+        system::Thread* createThread(system::ThreadLaunchMode tlm);
+
+        /// \brief Starts a thread with a new storage, at the next index of the registry. `threads_mtx_` must be held.
+        system::Thread* appendThread(const system::topology::WorkerSlot& slot);
     };
 }
 
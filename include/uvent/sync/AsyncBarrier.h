@@ -17,16 +17,19 @@ namespace usub::uvent::sync {
             AsyncBarrier& b;
 
             struct Node {
-                std::coroutine_handle<> h{};
-                Node*                   next{};
-                int                     thread_id{-1};
+                uvent::detail::WakeHandle h{};
+                Node*                     next{};
+                int                       thread_id{-1};
+                task::Priority            priority{task::Priority::NORMAL};
             } node{};
 
             bool await_ready() const noexcept { return false; }
 
-            bool await_suspend(std::coroutine_handle<> h) {
+            template <class P>
+            bool await_suspend(std::coroutine_handle<P> h) {
                 node.h         = h;
                 node.thread_id = detail::current_thread_id();
+                node.priority  = system::this_thread::detail::cur_priority;
 
                 b.lock_();
 
@@ -39,9 +42,10 @@ namespace usub::uvent::sync {
 
                     b.unlock_();
 
+                    detail::WakeBatch wake;
                     while (list) {
                         Node* next = list->next;
-                        detail::resume_on(list->h, list->thread_id);
+                        wake.add(list->h, list->thread_id, list->priority);
                         list = next;
                     }
                     return false;
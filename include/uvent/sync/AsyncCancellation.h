@@ -18,10 +18,11 @@ namespace usub::uvent::sync {
         };
 
         struct WaitNode {
-            std::coroutine_handle<>  h{};
-            WaitNode*                next{};
-            int                      thread_id{-1};
-            std::atomic<NodeState>   st{NodeState::Waiting};
+            uvent::detail::WakeHandle  h{};
+            WaitNode*                  next{};
+            int                        thread_id{-1};
+            task::Priority             priority{task::Priority::NORMAL};
+            std::atomic<NodeState>     st{NodeState::Waiting};
         };
 
         std::atomic<bool>       requested{false};
@@ -80,12 +81,14 @@ namespace usub::uvent::sync {
                 return s->requested.load(std::memory_order_acquire);
             }
 
-            bool await_suspend(std::coroutine_handle<> h) noexcept {
+            template <class P>
+            bool await_suspend(std::coroutine_handle<P> h) noexcept {
                 using NodeState = CancelState::NodeState;
 
                 node = new CancelState::WaitNode{};
                 node->h         = h;
                 node->thread_id = detail::current_thread_id();
+                node->priority  = system::this_thread::detail::cur_priority;
                 node->st.store(NodeState::Waiting, std::memory_order_relaxed);
 
                 s->push_waiter(node);
@@ -124,6 +127,7 @@ namespace usub::uvent::sync {
             if (was) return;
 
             CancelState::WaitNode* list = state_.exchange_all();
+            detail::WakeBatch wake;
             while (list) {
                 auto* n  = list;
                 list     = list->next;
@@ -133,7 +137,7 @@ namespace usub::uvent::sync {
                         exp, NodeState::Claimed,
                         std::memory_order_acq_rel,
                         std::memory_order_relaxed)) {
-                    detail::resume_on(n->h, n->thread_id);
+                    wake.add(n->h, n->thread_id, n->priority);
                 }
                 delete n;
             }
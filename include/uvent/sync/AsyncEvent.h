@@ -21,10 +21,11 @@ namespace usub::uvent::sync {
         };
 
         struct WaitNode {
-            std::coroutine_handle<>  h{};
-            WaitNode*                next{};
-            int                      thread_id{-1};
-            std::atomic<NodeState>   st{NodeState::Waiting};
+            uvent::detail::WakeHandle  h{};
+            WaitNode*                  next{};
+            int                        thread_id{-1};
+            task::Priority             priority{task::Priority::NORMAL};
+            std::atomic<NodeState>     st{NodeState::Waiting};
         };
 
         const Reset              reset_;
@@ -104,10 +105,12 @@ namespace usub::uvent::sync {
                 return self->set_.load(std::memory_order_acquire);
             }
 
-            bool await_suspend(std::coroutine_handle<> h) noexcept {
+            template <class P>
+            bool await_suspend(std::coroutine_handle<P> h) noexcept {
                 node = new WaitNode{};
                 node->h         = h;
                 node->thread_id = detail::current_thread_id();
+                node->priority  = system::this_thread::detail::cur_priority;
                 node->st.store(NodeState::Waiting, std::memory_order_relaxed);
 
                 self->push_waiter(node);
@@ -140,7 +143,7 @@ namespace usub::uvent::sync {
 
                     if (try_claim(n)) {
                         set_.store(false, std::memory_order_release);
-                        detail::resume_on(n->h, n->thread_id);
+                        detail::resume_on(n->h, n->thread_id, n->priority);
                         delete n;
                         return;
                     }
@@ -148,10 +151,11 @@ namespace usub::uvent::sync {
                 }
             } else {
                 WaitNode* list = exchange_all();
+                detail::WakeBatch wake;
                 while (list) {
                     WaitNode* next = list->next;
                     if (try_claim(list))
-                        detail::resume_on(list->h, list->thread_id);
+                        wake.add(list->h, list->thread_id, list->priority);
                     delete list;
                     list = next;
                 }
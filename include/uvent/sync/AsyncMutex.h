@@ -12,9 +12,10 @@ namespace usub::uvent::sync {
 
     class AsyncMutex {
         struct WaitNode {
-            std::coroutine_handle<>  h{};
-            WaitNode*                next{};
-            int                      thread_id{-1};
+            uvent::detail::WakeHandle  h{};
+            WaitNode*                  next{};
+            int                        thread_id{-1};
+            task::Priority             priority{task::Priority::NORMAL};
         };
 
         std::atomic<std::uintptr_t> state_{0};
@@ -45,8 +46,12 @@ namespace usub::uvent::sync {
             WaitNode    node{};
 
             bool await_ready() noexcept;
-            bool await_suspend(std::coroutine_handle<> h) noexcept;
+            template <class P>
+            bool await_suspend(std::coroutine_handle<P> h) noexcept { return this->suspend(h); }
             Guard await_resume() noexcept;
+
+        private:
+            bool suspend(uvent::detail::WakeHandle h) noexcept;
         };
 
         LockAwaiter lock() noexcept;
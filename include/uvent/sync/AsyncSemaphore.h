@@ -19,9 +19,10 @@ namespace usub::uvent::sync {
         };
 
         struct WaitNode {
-            std::coroutine_handle<>    h{};
+            uvent::detail::WakeHandle  h{};
             WaitNode*                  next{};
             int                        thread_id{-1};
+            task::Priority             priority{task::Priority::NORMAL};
             std::atomic<NodeState>     st{NodeState::Waiting};
         };
 
@@ -80,10 +81,12 @@ namespace usub::uvent::sync {
                 return self->try_take_token();
             }
 
-            bool await_suspend(std::coroutine_handle<> h) noexcept {
+            template <class P>
+            bool await_suspend(std::coroutine_handle<P> h) noexcept {
                 node = new WaitNode{};
                 node->h         = h;
                 node->thread_id = detail::current_thread_id();
+                node->priority  = system::this_thread::detail::cur_priority;
                 node->st.store(NodeState::Waiting, std::memory_order_relaxed);
 
                 self->push_waiter(node);
@@ -109,27 +112,40 @@ namespace usub::uvent::sync {
         bool try_acquire() noexcept { return try_take_token(); }
 
         void release(int32_t k = 1) noexcept {
-            for (int32_t i = 0; i < k; ++i) {
-                for (;;) {
-                    WaitNode* n = pop_waiter();
-                    if (!n) {
-                        count_.fetch_add(1, std::memory_order_release);
-                        break;
-                    }
+            if (k == 1) {
+                release_one(nullptr);
+                return;
+            }
+            // several waiters at once: hand them to their threads in bulk
+            detail::WakeBatch wake;
+            for (int32_t i = 0; i < k; ++i)
+                release_one(&wake);
+        }
 
-                    NodeState expected = NodeState::Waiting;
-                    if (!n->st.compare_exchange_strong(
-                            expected, NodeState::Claimed,
-                            std::memory_order_acq_rel,
-                            std::memory_order_relaxed)) {
-                        delete n;
-                        continue;
-                    }
+    private:
+        void release_one(detail::WakeBatch* wake) noexcept {
+            for (;;) {
+                WaitNode* n = pop_waiter();
+                if (!n) {
+                    count_.fetch_add(1, std::memory_order_release);
+                    break;
+                }
 
-                    detail::resume_on(n->h, n->thread_id);
+                NodeState expected = NodeState::Waiting;
+                if (!n->st.compare_exchange_strong(
+                        expected, NodeState::Claimed,
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed)) {
                     delete n;
-                    break;
+                    continue;
                 }
+
+                if (wake)
+                    wake->add(n->h, n->thread_id, n->priority);
+                else
+                    detail::resume_on(n->h, n->thread_id, n->priority);
+                delete n;
+                break;
             }
         }
     };
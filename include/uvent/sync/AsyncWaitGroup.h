@@ -30,7 +30,8 @@ namespace usub::uvent::sync {
                 return self->cnt_.load(std::memory_order_acquire) == 0;
             }
 
-            bool await_suspend(std::coroutine_handle<> h) noexcept {
+            template <class P>
+            bool await_suspend(std::coroutine_handle<P> h) noexcept {
                 if (self->cnt_.load(std::memory_order_acquire) == 0)
                     return false;
                 auto a = self->sem_.acquire();
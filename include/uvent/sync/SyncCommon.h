@@ -16,13 +16,85 @@ namespace usub::uvent::sync::detail {
             && static_cast<uint32_t>(tid) < system::global::detail::thread_count;
     }
 
-    inline void resume_on(std::coroutine_handle<> h, int tid) noexcept {
-        if (is_valid_thread_id(tid))
-            system::co_spawn_static(h, tid);
+    /// \brief Resumes waiter @p h on thread @p tid in the class it suspended in.
+    inline void resume_on(uvent::detail::WakeHandle h, int tid, task::Priority priority) noexcept {
+        if (tid == current_thread_id() && system::this_thread::detail::tls)
+            system::this_thread::detail::enqueue_ready(h.handle(), priority);
+        else if (is_valid_thread_id(tid))
+            system::co_spawn_static(h.to_frame(priority), tid);
         else
-            system::co_spawn(h);
+            system::co_spawn(h.to_frame(priority));
     }
 
+    /**
+     * @brief Collects coroutines to wake and resumes them grouped by target thread.
+     *
+     * Each group is handed over with one bulk inbox enqueue and one doorbell instead of one
+     * enqueue per coroutine; runtime frames are linked into the chain through their own frame.
+     * Coroutines of the calling thread go straight to its run queue.
+     * Handles are queued when the batch fills up, on `flush()` and on destruction.
+     */
+    class WakeBatch {
+    public:
+        WakeBatch() noexcept = default;
+
+        WakeBatch(const WakeBatch &) = delete;
+
+        WakeBatch &operator=(const WakeBatch &) = delete;
+
+        ~WakeBatch() { flush(); }
+
+        void add(uvent::detail::WakeHandle h, int tid, task::Priority priority) noexcept {
+            if (n_ == CAPACITY)
+                flush();
+            entries_[n_++] = Entry{h, tid, priority};
+        }
+
+        void flush() noexcept {
+            Entry group[CAPACITY];
+            std::coroutine_handle<uvent::detail::AwaitableFrameBase> frames[CAPACITY];
+            const int self = system::this_thread::detail::tls ? current_thread_id() : -1;
+            size_t remaining = n_;
+            n_ = 0;
+            // remaining entries are kept compacted at the front; each pass takes out one thread's group
+            while (remaining > 0) {
+                const int tid = entries_[0].tid;
+                size_t g = 0, kept = 0;
+                for (size_t i = 0; i < remaining; ++i) {
+                    if (entries_[i].tid == tid)
+                        group[g++] = entries_[i];
+                    else
+                        entries_[kept++] = entries_[i];
+                }
+                remaining = kept;
+
+                if (tid == self && self >= 0) {
+                    for (size_t i = 0; i < g; ++i)
+                        system::this_thread::detail::enqueue_ready(group[i].h.handle(), group[i].priority);
+                } else if (is_valid_thread_id(tid)) {
+                    for (size_t i = 0; i < g; ++i)
+                        frames[i] = group[i].h.to_frame(group[i].priority);
+                    system::global::detail::tls_registry->getStorage(tid)->push_tasks_inbox(frames, g);
+                } else {
+                    for (size_t i = 0; i < g; ++i)
+                        system::co_spawn(group[i].h.to_frame(group[i].priority));
+                }
+            }
+        }
+
+    private:
+        static constexpr size_t CAPACITY = 128;
+
+        struct Entry {
+            uvent::detail::WakeHandle h;
+            int tid;
+            task::Priority priority;
+        };
+
+        Entry entries_[CAPACITY];
+        size_t n_{0};
+    };
+
 } // namespace usub::uvent::sync::detail
 
 #endif // UVENT_SYNC_COMMON_H
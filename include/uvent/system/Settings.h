@@ -75,8 +75,101 @@ namespace usub::uvent::settings
      *
      * Defines how often an idle worker thread wakes up to check for new tasks
      * when no work is currently available in its queue.
+     * Upper bound of a single park in the poller, also when the next timer is further away.
      */
     extern int idle_fallback_ms;
+
+    /**
+     * @brief Upper bound of the adaptive idle spin, in microseconds.
+     *
+     * An idle worker first spins (polling I/O without blocking and checking its queues), then
+     * yields the CPU `idle_yield_rounds` times, and only then blocks in the poller.
+     * The spin window doubles whenever work arrives while spinning and halves whenever the thread parks,
+     * staying within [`idle_spin_min_us`, `idle_spin_max_us`]. Set to 0 to park immediately.
+     */
+    extern int idle_spin_max_us;
+
+    /**
+     * @brief Lower bound of the adaptive idle spin, in microseconds.
+     */
+    extern int idle_spin_min_us;
+
+    /**
+     * @brief Number of `std::this_thread::yield()` rounds between the idle spin and parking in the poller.
+     */
+    extern int idle_yield_rounds;
+
+    /**
+     * @brief Capacity of each worker's stealable run queue.
+     *
+     * Coroutines spawned with `co_spawn()` from inside a worker are placed into that
+     * worker's own run queue; idle workers steal half of a victim's queue at a time.
+     * When the queue is full, spawns overflow into the global task queue.
+     * Rounded up to a power of two. Must be set before `Uvent` is constructed.
+     */
+    extern int local_queue_capacity;
+
+    /**
+     * @brief Maximum number of LIFO-slot continuations run back to back after one queued task.
+     *
+     * When a coroutine starts a child or completes and wakes its parent once the symmetric transfer
+     * budget is spent, the woken frame is placed into a single per-thread "next task" slot and resumed right after the current task, while its
+     * frame is still in cache. After this many consecutive slot resumes the slot is flushed to the tail
+     * of the local queue, so chains of handoffs cannot starve other queued tasks.
+     * Set to 0 to disable the fast path.
+     */
+    extern int max_lifo_slot_chain;
+
+    /**
+     * @brief Maximum number of direct (symmetric) transfers between coroutines per scheduler resume.
+     *
+     * `co_await child()` resumes the child directly and a finishing child resumes its awaiting parent
+     * directly, without a trip through the run queue. Each such transfer consumes one unit; once the
+     * budget of the current resume is spent, the next handoff goes through the LIFO slot instead. This
+     * bounds stack depth where the compiler does not turn the transfer into a tail call and keeps long
+     * await chains from starving other tasks. Set to 0 to always go through the scheduler.
+     */
+    extern int max_symmetric_transfers_per_resume;
+
+    /**
+     * @brief Maximum number of `Priority::BACKGROUND` tasks resumed per worker loop iteration.
+     *
+     * Background tasks run only after latency-critical and normal tasks of the iteration are drained;
+     * this quota bounds how long they can delay the next poll.
+     */
+    extern int max_background_tasks_per_iteration;
+
+    /**
+     * @brief Number of socket operations a coroutine may perform per resume before it is forced to yield.
+     *
+     * Socket operations that complete immediately (data already buffered) do not suspend, so without
+     * a budget a busy connection could keep its worker forever. Once the budget is exhausted the next
+     * operation yields back to the loop first.
+     */
+    extern int max_io_ops_per_resume;
+
+    /**
+     * @brief Capacity (events, rounded up to a power of two) of each thread's trace ring buffer.
+     *
+     * Only used when the library is built with `UVENT_ENABLE_TRACING`. Once full, the oldest events
+     * are overwritten.
+     */
+    extern int trace_buffer_events;
+
+    /**
+     * @brief Maximum number of free coroutine frames a thread keeps per size class.
+     *
+     * Frames beyond this are returned to the global allocator instead of being cached.
+     */
+    extern int max_cached_frames_per_class;
+
+    /**
+     * @brief Number of threads of the blocking pool used by `system::offload()`.
+     *
+     * Independent of the number of event-loop workers. The threads are started on the first
+     * offload, so the value must be set before it.
+     */
+    extern int blocking_pool_threads;
 }
 
 #endif //UVENT_SETTINGS_H
@@ -5,12 +5,15 @@
 #ifndef UVENT_SYSTEMCONTEXT_H
 #define UVENT_SYSTEMCONTEXT_H
 
+#include <algorithm>
 #include <chrono>
+#include <concepts>
 #include <memory>
 #include <uvent/pool/TLSRegistry.h>
 #include "Settings.h"
 #include "uvent/base/Predefines.h"
 #include "uvent/poll/PollerBase.h"
+#include "uvent/tasks/Priority.h"
 #include "uvent/tasks/SharedTasks.h"
 #include "uvent/utils/datastructures/queue/ConcurrentQueues.h"
 #include "uvent/utils/datastructures/queue/FastQueue.h"
@@ -29,6 +32,56 @@ namespace usub::uvent::system
     {
         inline std::unique_ptr<thread::TLSRegistry> tls_registry{nullptr};
         extern std::atomic<int> thread_count;
+        /// \brief Number of workers currently blocked in their poller.
+        inline std::atomic<int> parked_threads{0};
+
+        /**
+         * @brief Wakes one parked worker, if any, so it can pick up (or steal) newly shared work.
+         *
+         * Best effort: it is not fenced against a worker that is just about to park, such a worker
+         * is bounded by `settings::idle_fallback_ms`.
+         */
+        void wake_parked_worker();
+
+        inline void notify_parked_worker()
+        {
+            if (parked_threads.load(std::memory_order_relaxed) > 0)
+                wake_parked_worker();
+        }
+
+        /**
+         * @brief Samples two random non-retired workers and returns the less loaded one.
+         *
+         * Load is `ThreadLocalStorage::load()`.
+         *
+         * @return Index of the chosen worker, or -1 if no suitable worker was sampled.
+         */
+        int pick_balanced_worker();
+
+        /// \brief Handles gathered on the stack per bulk enqueue of `co_spawn_bulk()` and `co_spawn_static_bulk()`.
+        inline constexpr size_t spawn_bulk_chunk = 256;
+
+        /// \brief Calls `sink(handles, n)` for the coroutines of @p tasks, in chunks of up to `spawn_bulk_chunk`.
+        template <class Handle, class R, class Sink>
+        void for_each_handle_chunk(R& tasks, Sink&& sink)
+        {
+            Handle buf[spawn_bulk_chunk];
+            size_t n = 0;
+            for (auto& t : tasks)
+            {
+                auto promise = t.get_promise();
+                if (!promise)
+                    continue;
+                buf[n++] = promise->get_coroutine_handle();
+                if (n == spawn_bulk_chunk)
+                {
+                    sink(buf, n);
+                    n = 0;
+                }
+            }
+            if (n != 0)
+                sink(buf, n);
+        }
     } // namespace global::detail
 
     /// \brief Variables used internally within the system.
@@ -36,6 +89,13 @@ namespace usub::uvent::system
     /// documentation.
     namespace this_thread::detail
     {
+        /// \brief Ready coroutine together with the class it was made ready in.
+        struct ReadyTask
+        {
+            std::coroutine_handle<> h;
+            task::Priority priority;
+        };
+
 #ifndef UVENT_ENABLE_REUSEADDR
         /// \brief Wrapper over I/O notification mechanism provided by OS.
         extern std::unique_ptr<core::PollerBase> pl;
@@ -52,8 +112,26 @@ namespace usub::uvent::system
         extern std::unique_ptr<task::SharedTasks> st;
         /// \brief Currently executing coroutine (cec).
         thread_local extern std::coroutine_handle<> cec;
+        /// \brief Priority class of the currently executing coroutine, inherited by coroutines it creates.
+        thread_local extern task::Priority cur_priority;
         /// \brief Thread's index inside thread pool.
         thread_local extern int t_id;
+        /// \brief Storage of the current worker thread, nullptr outside the thread pool.
+        thread_local extern thread::ThreadLocalStorage* tls;
+        /// \brief LIFO "next task" slot: the most recent parent/child handoff, resumed right after the current task.
+        thread_local extern std::coroutine_handle<> lifo;
+        /// \brief Class of the handle in `lifo`.
+        thread_local extern task::Priority lifo_priority;
+        /// \brief Ready latency-critical coroutines, resumed before any other class.
+        thread_local extern queue::single_thread::Queue<std::coroutine_handle<>> q_lc;
+        /// \brief Ready background coroutines, resumed in a bounded quota once the other classes are drained.
+        thread_local extern queue::single_thread::Queue<std::coroutine_handle<>> q_bg;
+        /// \brief Coroutines that yielded in the current loop iteration, re-queued after it.
+        thread_local extern queue::single_thread::Queue<ReadyTask> q_y;
+        /// \brief Remaining I/O operations the current resume may perform before being forced to yield.
+        thread_local extern int op_budget;
+        /// \brief Remaining direct coroutine-to-coroutine transfers the current resume may perform.
+        thread_local extern int transfer_budget;
         /// \brief Coroutines to be destroyed
         thread_local extern queue::single_thread::Queue<std::coroutine_handle<>> q_c;
 #ifndef UVENT_ENABLE_REUSEADDR
@@ -68,10 +146,69 @@ namespace usub::uvent::system
 #else
         extern bool is_started;
 #endif
+
+        /**
+         * @brief Makes @p h ready on the calling thread in the run queue of class @p priority.
+         *
+         * The frame is not read: @p h may be any coroutine. Wake-up sites pass the class recorded
+         * when the coroutine suspended (usually `cur_priority` at that point).
+         */
+        inline void enqueue_ready(std::coroutine_handle<> h, task::Priority priority)
+        {
+            switch (priority)
+            {
+                case task::Priority::LATENCY_CRITICAL:
+                    q_lc.enqueue(h);
+                    break;
+                case task::Priority::BACKGROUND:
+                    q_bg.enqueue(h);
+                    break;
+                default:
+                    q->enqueue(h);
+                    break;
+            }
+        }
+
+        /// \brief `enqueue_ready()` for a runtime frame, in the class stored in the frame.
+        inline void enqueue_frame(std::coroutine_handle<uvent::detail::AwaitableFrameBase> h)
+        {
+            enqueue_ready(h, h.promise().get_priority());
+        }
+
+        /// \brief Re-queues the current coroutine, in its current class, after this loop iteration.
+        inline void yield_ready(std::coroutine_handle<> h) { q_y.enqueue(ReadyTask{h, cur_priority}); }
     } // namespace this_thread::detail
 
     namespace this_coroutine
     {
+        struct YieldAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> h) const noexcept { this_thread::detail::yield_ready(h); }
+
+            void await_resume() const noexcept {}
+        };
+
+        /**
+         * @brief Suspends the current coroutine and gives the worker loop a chance to run other tasks.
+         *
+         * The coroutine is re-queued at the end of the current loop iteration, so it resumes after
+         * the next poll, behind the tasks that poll wakes up.
+         */
+        inline YieldAwaiter yield() noexcept { return {}; }
+
+        /**
+         * @brief Charges one operation against the budget of the current resume.
+         *
+         * Every resume of a coroutine starts with `settings::max_io_ops_per_resume` operations.
+         * Socket operations call this on entry and `co_await yield()` once it returns true,
+         * so a connection that always has data ready cannot monopolise its worker.
+         *
+         * @return true if the budget is exhausted and the caller should yield.
+         */
+        inline bool consume_budget() noexcept { return --this_thread::detail::op_budget < 0; }
+
         template <class Rep, class Period>
         task::Awaitable<void> sleep_for(std::chrono::duration<Rep, Period> d)
         {
@@ -86,7 +223,7 @@ namespace usub::uvent::system
 
                 void await_suspend(std::coroutine_handle<> h) const noexcept
                 {
-                    t->bind(h);
+                    t->bind(h, this_thread::detail::cur_priority);
                     this_thread::detail::wh.addTimer(t);
                 }
 
@@ -97,11 +234,43 @@ namespace usub::uvent::system
         }
     } // namespace this_coroutine
 
+    /**
+     * @brief Schedules the frame of a runtime coroutine for execution on any thread.
+     *
+     * Called from a worker thread, the handle goes to that worker's stealable run queue;
+     * otherwise, or if that queue is full, it goes to the global task queue.
+     */
+    inline void co_spawn(std::coroutine_handle<detail::AwaitableFrameBase> h)
+    {
+        if (auto* tls = this_thread::detail::tls; !tls || !tls->push_task_local(h))
+            this_thread::detail::st->enqueue(h);
+        global::detail::notify_parked_worker();
+    }
+
+    /**
+     * @brief Schedules any coroutine handle for execution on any thread.
+     *
+     * The run queues hold runtime frames only, so @p h is wrapped in a pooled frame that resumes it
+     * (`detail::wrap_foreign()`). Pass `promise->get_coroutine_handle()` of a runtime coroutine to
+     * skip the wrapper.
+     */
+    inline void co_spawn(std::coroutine_handle<> h) { co_spawn(detail::wrap_foreign(h)); }
+
+    /// \brief `co_spawn()` for the typed handle of any runtime promise type: the frame is queued as is.
+    template <class P>
+        requires std::derived_from<P, detail::AwaitableFrameBase>
+    void co_spawn(std::coroutine_handle<P> h)
+    {
+        co_spawn(std::coroutine_handle<detail::AwaitableFrameBase>::from_promise(h.promise()));
+    }
+
     /**
      * @brief Spawns a coroutine for execution in the global thread context.
      *
      * Retrieves the coroutine promise from the given function object and, if valid,
-     * enqueues its coroutine handle into the global task queue.
+     * enqueues its coroutine handle for execution on any thread.
+     * Called from a worker thread, the handle goes to that worker's stealable run queue
+     * (idle workers steal from it); otherwise, or if that queue is full, it goes to the global task queue.
      *
      * @tparam F Coroutine function type providing `get_promise()`.
      * @param f Coroutine function to be spawned.
@@ -114,10 +283,188 @@ namespace usub::uvent::system
     {
         auto promise = f.get_promise();
         if (promise)
-            this_thread::detail::st->enqueue(promise->get_coroutine_handle());
+            co_spawn(promise->get_coroutine_handle());
+    }
+
+    /**
+     * @brief Spawns a coroutine with the given priority class.
+     *
+     * Same placement rules as `co_spawn(f)`. The class is stored in the coroutine frame and
+     * inherited by coroutines it creates; see `task::Priority`.
+     *
+     * @tparam F Coroutine function type providing `get_promise()`.
+     * @param f Coroutine function to be spawned.
+     * @param priority Scheduling class of the coroutine.
+     */
+    template <typename F>
+    void co_spawn(F&& f, task::Priority priority)
+    {
+        auto promise = f.get_promise();
+        if (promise)
+        {
+            promise->set_priority(priority);
+            co_spawn(promise->get_coroutine_handle());
+        }
     }
 
-    inline void co_spawn(std::coroutine_handle<> h) { this_thread::detail::st->enqueue(h); }
+    namespace global::detail
+    {
+        /**
+         * @brief Schedules @p n runtime frames on any thread with one enqueue per queue.
+         *
+         * Same placement as `co_spawn(h)`: the caller's stealable run queue first (one publication for
+         * all the handles that fit), the rest into the global task queue (bulk claim of ring cells).
+         * At most one parked worker is woken. Every handle must come from `get_coroutine_handle()`.
+         */
+        inline void spawn_frames_bulk(const std::coroutine_handle<>* frames, size_t n)
+        {
+            if (n == 0)
+                return;
+            size_t pushed = 0;
+            if (auto* tls = this_thread::detail::tls)
+                pushed = tls->push_tasks_local(frames, n);
+            if (pushed < n)
+                this_thread::detail::st->enqueue_bulk(frames + pushed, n - pushed);
+            notify_parked_worker();
+        }
+    } // namespace global::detail
+
+    /**
+     * @brief Spawns every coroutine of @p tasks, like `co_spawn(f)` for each but in bulk.
+     *
+     * Meant for fan-out: a handler starting hundreds of sub-coroutines pays one queue reservation per
+     * chunk of `global::detail::spawn_bulk_chunk` coroutines instead of one per coroutine.
+     *
+     * @code
+     * std::vector<task::Awaitable<void>> parts;
+     * for (auto& shard : shards) parts.push_back(query(shard));
+     * system::co_spawn_bulk(parts);
+     * @endcode
+     *
+     * @tparam R Range of coroutine objects providing `get_promise()`.
+     */
+    template <typename R>
+    void co_spawn_bulk(R&& tasks)
+    {
+        global::detail::for_each_handle_chunk<std::coroutine_handle<>>(
+            tasks, [](const std::coroutine_handle<>* hs, size_t n) { global::detail::spawn_frames_bulk(hs, n); });
+    }
+
+    /**
+     * @brief Schedules the frame of a runtime coroutine without ever spilling into an overflow list.
+     *
+     * Tries the caller's stealable run queue (inside a worker) and then the lock-free ring of the
+     * global task queue.
+     *
+     * @return false if both are full. The handle is not scheduled and still belongs to the caller.
+     */
+    [[nodiscard]] inline bool try_co_spawn(std::coroutine_handle<detail::AwaitableFrameBase> h)
+    {
+        if (auto* tls = this_thread::detail::tls; !tls || !tls->push_task_local(h))
+        {
+            if (!this_thread::detail::st->try_enqueue(h))
+                return false;
+        }
+        global::detail::notify_parked_worker();
+        return true;
+    }
+
+    /// \brief `try_co_spawn()` for any coroutine handle, wrapped like by `co_spawn(std::coroutine_handle<>)`.
+    [[nodiscard]] inline bool try_co_spawn(std::coroutine_handle<> h)
+    {
+        const auto wrapper = detail::wrap_foreign(h);
+        if (try_co_spawn(wrapper))
+            return true;
+        wrapper.destroy();
+        return false;
+    }
+
+    /**
+     * @brief Spawns a coroutine unless the runtime's task queues are saturated.
+     *
+     * Same placement rules as `co_spawn()`, but instead of falling back to the slow overflow path
+     * it reports saturation to the caller, which can shed load (e.g. close a freshly accepted socket).
+     *
+     * @tparam F Coroutine function type providing `get_promise()`.
+     * @param f Coroutine function to be spawned.
+     * @return true if the coroutine was scheduled. On false the coroutine frame has been destroyed
+     *         without running.
+     */
+    template <typename F>
+    [[nodiscard]] bool try_co_spawn(F&& f)
+    {
+        auto promise = f.get_promise();
+        if (!promise)
+            return false;
+        auto h = promise->get_coroutine_handle();
+        if (try_co_spawn(h))
+            return true;
+        h.destroy();
+        return false;
+    }
+
+    /**
+     * @brief Spawns a coroutine, suspending the caller while the runtime's task queues are saturated.
+     *
+     * Retries `try_co_spawn()` first after a `yield()`, which lets the calling worker drain its own
+     * run queue, then with a timer backoff doubling from 1 ms up to 16 ms. A producer that spawns in a
+     * loop (e.g. an accept loop) is slowed down to the rate at which workers drain their queues without
+     * polling them every millisecond while they stay saturated.
+     *
+     * @tparam F Coroutine function type providing `get_promise()`.
+     * @param f Coroutine function to be spawned.
+     */
+    template <typename F>
+    task::Awaitable<void> co_spawn_wait(F f)
+    {
+        auto promise = f.get_promise();
+        if (!promise)
+            co_return;
+        const auto h = promise->get_coroutine_handle();
+        if (try_co_spawn(h))
+            co_return;
+        co_await this_coroutine::yield();
+        for (std::chrono::milliseconds backoff{1}; !try_co_spawn(h);
+             backoff = std::min(backoff * 2, std::chrono::milliseconds(16)))
+            co_await this_coroutine::sleep_for(backoff);
+    }
+
+    /**
+     * @brief Schedules the frame of a runtime coroutine on the less loaded of two randomly sampled workers.
+     *
+     * The handle goes to the inbox of the chosen worker, so the coroutine stays there unless it
+     * is re-spawned. Falls back to `co_spawn(h)` when no worker can be sampled (e.g. every sample is retired).
+     */
+    inline void co_spawn_balanced(std::coroutine_handle<detail::AwaitableFrameBase> h)
+    {
+        if (const int idx = global::detail::pick_balanced_worker(); idx >= 0)
+            global::detail::tls_registry->getStorage(idx)->push_task_inbox(h);
+        else
+            co_spawn(h);
+    }
+
+    /// \brief `co_spawn_balanced()` for any coroutine handle, wrapped like by `co_spawn(std::coroutine_handle<>)`.
+    inline void co_spawn_balanced(std::coroutine_handle<> h) { co_spawn_balanced(detail::wrap_foreign(h)); }
+
+    /**
+     * @brief Spawns a coroutine on a worker chosen by load (power of two choices).
+     *
+     * Samples two workers, compares their load (run-queue depth, queued inbox tasks and live sockets,
+     * see `thread::ThreadLocalStorage::load()`) and places the coroutine in the inbox of the lighter one.
+     * Meant for long-lived coroutines such as connection handlers, whose cost is spread unevenly:
+     * `co_spawn` balances only through stealing of queued tasks, which does not move a coroutine
+     * once it waits on its sockets.
+     *
+     * @tparam F Coroutine function type providing `get_promise()`.
+     * @param f Coroutine function to be spawned.
+     */
+    template <typename F>
+    void co_spawn_balanced(F&& f)
+    {
+        auto promise = f.get_promise();
+        if (promise)
+            co_spawn_balanced(promise->get_coroutine_handle());
+    }
 
     /**
      * @brief Enqueues a coroutine into the inbox of a specific thread.
@@ -146,14 +493,31 @@ namespace usub::uvent::system
     }
 
     /**
-     * @brief Enqueues an existing coroutine handle into the inbox of a specific thread.
+     * @brief Enqueues the frame of a runtime coroutine into the inbox of a specific thread.
      *
-     * Places the provided coroutine handle into the target thread’s inbox queue for later execution.
+     * The frame itself is linked into the target thread’s inbox queue, nothing is allocated.
      *
      * This function is safe to call at any time (both before and after the event loop starts).
      * If the target thread/event-loop is already running, the task will be picked up by the runtime
      * according to the inbox processing rules of that thread.
      *
+     * @param h Handle obtained from `get_coroutine_handle()` of a runtime frame.
+     * @param threadIndex Index of the target thread whose inbox receives the coroutine.
+     *
+     * @warning This function stores only the coroutine handle; it does not extend coroutine lifetime.
+     *          The coroutine must remain valid until executed/destroyed by the runtime.
+     */
+    inline void co_spawn_static(std::coroutine_handle<detail::AwaitableFrameBase> h, int threadIndex)
+    {
+        global::detail::tls_registry->getStorage(threadIndex)->push_task_inbox(h);
+    }
+
+    /**
+     * @brief Enqueues any coroutine handle into the inbox of a specific thread.
+     *
+     * A bare handle may belong to a coroutine with any promise type, so it is wrapped in a pooled
+     * runtime frame that resumes it (`detail::wrap_foreign()`); the wrapper is what gets linked.
+     *
      * @param h Coroutine handle to be enqueued.
      * @param threadIndex Index of the target thread whose inbox receives the coroutine.
      *
@@ -165,6 +529,72 @@ namespace usub::uvent::system
         global::detail::tls_registry->getStorage(threadIndex)->push_task_inbox(h);
     }
 
+    /// \brief `co_spawn_static()` for the typed handle of any runtime promise type: the frame is linked as is.
+    template <class P>
+        requires std::derived_from<P, detail::AwaitableFrameBase>
+    void co_spawn_static(std::coroutine_handle<P> h, int threadIndex)
+    {
+        co_spawn_static(std::coroutine_handle<detail::AwaitableFrameBase>::from_promise(h.promise()), threadIndex);
+    }
+
+    /**
+     * @brief Enqueues a coroutine with the given priority class into the inbox of a specific thread.
+     *
+     * @param f Coroutine function/object to be enqueued.
+     * @param threadIndex Index of the target thread whose inbox receives the coroutine.
+     * @param priority Scheduling class of the coroutine; see `task::Priority`.
+     */
+    template <typename F>
+    void co_spawn_static(F&& f, int threadIndex, task::Priority priority)
+    {
+        auto promise = f.get_promise();
+        if (promise)
+        {
+            promise->set_priority(priority);
+            global::detail::tls_registry->getStorage(threadIndex)->push_task_inbox(promise->get_coroutine_handle());
+        }
+    }
+
+    /**
+     * @brief Enqueues every coroutine of @p tasks into the inbox of a specific thread.
+     *
+     * The coroutines are linked together first and published with a single exchange and a single
+     * doorbell per chunk of `global::detail::spawn_bulk_chunk` coroutines.
+     *
+     * @tparam R Range of coroutine objects providing `get_promise()`.
+     * @param tasks Coroutines to be enqueued.
+     * @param threadIndex Index of the target thread whose inbox receives the coroutines.
+     */
+    template <typename R>
+    void co_spawn_static_bulk(R&& tasks, int threadIndex)
+    {
+        auto* storage = global::detail::tls_registry->getStorage(threadIndex);
+        using Frame = std::coroutine_handle<detail::AwaitableFrameBase>;
+        global::detail::for_each_handle_chunk<Frame>(tasks, [storage](const Frame* hs, size_t n)
+                                                     { storage->push_tasks_inbox(hs, n); });
+    }
+
+    /**
+     * @brief Enqueues a coroutine into the inbox of a specific thread unless that inbox is full.
+     *
+     * @param f Coroutine function/object to be enqueued.
+     * @param threadIndex Index of the target thread whose inbox receives the coroutine.
+     * @return true if the coroutine was enqueued. On false the coroutine frame has been destroyed
+     *         without running.
+     */
+    template <typename F>
+    [[nodiscard]] bool try_co_spawn_static(F&& f, int threadIndex)
+    {
+        auto promise = f.get_promise();
+        if (!promise)
+            return false;
+        auto h = promise->get_coroutine_handle();
+        if (global::detail::tls_registry->getStorage(threadIndex)->try_push_task_inbox(h))
+            return true;
+        h.destroy();
+        return false;
+    }
+
     /**
      * @brief Enqueues a coroutine into the inbox of a specific thread, optionally setting thread id in the promise.
      *
@@ -206,7 +636,7 @@ namespace usub::uvent::system
     }
 
     /**
-     * @brief Enqueues an existing coroutine handle into the inbox of a specific thread,
+     * @brief Enqueues a coroutine handle into the inbox of a specific thread,
      *        optionally setting thread id in the promise.
      *
      * Places the provided coroutine handle into the target thread’s inbox queue for later execution.
@@ -220,7 +650,8 @@ namespace usub::uvent::system
      *           `detail::AwaitableFrameBase` and implements `set_thread_id(int)`. The function will
      *           reinterpret the handle address as `std::coroutine_handle<detail::AwaitableFrameBase>`
      *           and call `promise().set_thread_id(threadIndex)`.
-     *         - `false`: no promise mutation is performed; `h` is enqueued as-is.
+     *         - `false`: no promise mutation is performed; `h` is enqueued like by
+     *           `co_spawn_static(std::coroutine_handle<>, int)`.
      *
      * @param h Coroutine handle to be enqueued.
      * @param threadIndex Index of the target thread whose inbox receives the coroutine.
@@ -234,7 +665,6 @@ namespace usub::uvent::system
     template <bool is_thread_id_set>
     inline void co_spawn_static(std::coroutine_handle<> h, int threadIndex)
     {
-        global::detail::tls_registry->getStorage(threadIndex)->push_task_inbox(h);
         if constexpr (is_thread_id_set)
         {
             auto handle = std::coroutine_handle<detail::AwaitableFrameBase>::from_address(h.address());
@@ -246,6 +676,55 @@ namespace usub::uvent::system
             global::detail::tls_registry->getStorage(threadIndex)->push_task_inbox(h);
     }
 
+    /// \brief Awaiter returned by `switch_to()`.
+    struct SwitchToAwaiter
+    {
+        int thread_index;
+
+        bool await_ready() const noexcept
+        {
+            return this->thread_index == this_thread::detail::t_id && this_thread::detail::tls;
+        }
+
+        template <class P>
+        void await_suspend(std::coroutine_handle<P> h) const
+        {
+            static_assert(std::is_base_of_v<uvent::detail::AwaitableFrameBase, P>,
+                          "switch_to() moves runtime coroutines (task::Awaitable) only");
+            // the frame may be resumed on the target as soon as it is pushed: update it first
+            const auto frame = std::coroutine_handle<uvent::detail::AwaitableFrameBase>::from_promise(h.promise());
+            frame.promise().set_thread_id(this->thread_index);
+            global::detail::tls_registry->getStorage(this->thread_index)->push_task_inbox(frame);
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Moves the calling coroutine to another worker.
+     *
+     * The coroutine suspends, its own frame is pushed into the inbox of @p thread_index and it
+     * resumes there; no frame, channel or allocation is involved. Awaiting it on the target worker
+     * itself completes immediately. Use it to reach state owned by one worker and come back:
+     *
+     * @code
+     * const int home = system::this_thread::detail::t_id;
+     * co_await system::switch_to(shard_owner(key));
+     * auto v = shard_lookup(key);
+     * co_await system::switch_to(home);
+     * @endcode
+     *
+     * @param thread_index Index of the target worker; must be valid, like for `co_spawn_static()`.
+     *
+     * The hop is not undone when the coroutine returns: the caller awaiting it is resumed by the
+     * coroutine's final suspend on the worker it finished on, so the caller continues there too.
+     *
+     * @warning Only for coroutines of the runtime (`task::Awaitable`); other promise types do not
+     *          compile. Sockets and timers stay with the worker that registered them, their
+     *          completions resume the coroutine there.
+     */
+    [[nodiscard]] inline SwitchToAwaiter switch_to(int thread_index) noexcept { return {thread_index}; }
+
     /**
      * @brief Schedules a timer in timer wheel.
      *
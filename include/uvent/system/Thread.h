@@ -13,6 +13,7 @@
 #include <stop_token>
 #include "uvent/system/Defines.h"
 #include "uvent/system/SystemContext.h"
+#include "uvent/system/Topology.h"
 #include "uvent/base/Predefines.h"
 #include <uvent/pool/TLSRegistry.h>
 
@@ -30,7 +31,7 @@ namespace usub::uvent::system
         friend class ThreadPool;
 
         Thread(std::barrier<>* barrier, int index, thread::ThreadLocalStorage* thread_local_storage,
-               ThreadLaunchMode tlm);
+               ThreadLaunchMode tlm, topology::WorkerSlot slot = {});
 
         Thread(Thread&&) noexcept = default;
 
@@ -44,16 +45,78 @@ namespace usub::uvent::system
 
         void run_current();
 
+        /**
+         * @brief Runs one loop iteration on the calling thread, which becomes this worker on the first call.
+         *
+         * Blocks in the poller for at most @p timeout_ms when there is nothing to run and never spins.
+         *
+         * @return Number of coroutines resumed, 0 once the thread has been stopped.
+         */
+        size_t poll_once(int timeout_ms);
+
+        /**
+         * @brief `poll_once()` only: releases the driving thread once the worker is stopped.
+         *
+         * Unregisters it from QSBR and drops its link to the worker storage, so it can outlive the pool. Does
+         * nothing unless called on the driving thread while it is attached.
+         */
+        void release_current() noexcept;
+
+        [[nodiscard]] bool stop_requested() const noexcept { return this->stop_source_.stop_requested(); }
+
         bool stop();
 
     private:
         void threadFunction(std::stop_token token);
 
+        /// \brief Binds the calling thread to this worker: placement, thread-locals, start barrier.
+        void attachCurrent();
+
+        void detachCurrent();
+
+        /**
+         * \brief One iteration of the worker loop.
+         * \param max_park_ms Upper bound of the time blocked in the poller, without spinning first;
+         *        negative for the regular idle policy of a dedicated thread.
+         */
+        void runIteration(int max_park_ms);
+
         void processInboxQueue();
 
+        /// \brief Resumes a task of class @p priority, then the continuations it hands off through the LIFO slot.
+        void runTask(std::coroutine_handle<> h, task::Priority priority);
+
+        void resumeTask(std::coroutine_handle<> h, task::Priority priority);
+
+        /// \brief Sorts the first @p n runtime frames of `tmp_tasks_` into the run queues of their classes.
+        void enqueueFrames(size_t n);
+
+        /// \brief True if any run queue, the inbox or the global queue holds work for this thread.
+        [[nodiscard]] bool hasPendingWork() const;
+
+        /**
+         * \brief Spin and yield phases of the idle policy.
+         * \return true if work showed up, false if the thread should park in the poller.
+         */
+        bool spinBeforePark();
+
+        /// \brief Polls the poller; a non-zero timeout is accounted as parked time.
+        void parkOrPoll(int timeout, bool lock = false);
+
+        /// \brief Single poller call, counted in the thread's stats. Returns true if it made coroutines runnable.
+        bool pollCounted(int timeout, bool lock);
+
+        /// \brief Publishes the loop counters into the thread's storage.
+        void publishStats();
+
+        /// \brief Retired thread only: moves its stealable run queue to the global queue.
+        void handOffSharedWork();
+
+        /// \brief Moves half of a random non-empty victim's run queue into the local queue, same-node victims first.
+        bool stealTasks();
+
     private:
         int index_;
-        std::jthread thread_;
         std::barrier<>* barrier;
         std::stop_source stop_source_;
         ThreadLaunchMode tlm{NEW};
@@ -61,6 +124,34 @@ namespace usub::uvent::system
         std::vector<net::SocketHeader*> tmp_sockets_;
         std::vector<std::coroutine_handle<>> tmp_coroutines_;
         thread::ThreadLocalStorage* thread_local_storage_;
+        /// \brief CPUs and NUMA node this thread is placed on.
+        topology::WorkerSlot slot_;
+        uint64_t steal_seed_{0x9E3779B97F4A7C15ull};
+        /// \brief Current adaptive spin window of the idle policy, in microseconds.
+        int spin_us_{1};
+        /// \brief `poll_once()` only: the driving thread has been attached.
+        bool attached_{false};
+        /// \brief `poll_once()` only: the driving thread.
+        std::thread::id host_{};
+        /// \brief Plain counters of the worker loop, published once per iteration.
+        struct
+        {
+            uint64_t resumed{0};
+            uint64_t polls{0};
+            uint64_t poll_events{0};
+            uint64_t empty_polls{0};
+            uint64_t timers_fired{0};
+            uint64_t destroyed{0};
+        } counters_;
+
+        // declared last: the loop is stopped and joined before the buffers and queues it works on are destroyed
+        std::jthread thread_;
+
+        /// \brief Upper bound of tasks taken from the own stealable queue at once, the rest stays stealable.
+        static constexpr size_t LOCAL_POP_BATCH = 32;
+
+        /// \brief Upper bound of tasks taken from the global queue per loop iteration.
+        static constexpr size_t SHARED_POP_BATCH = 64;
     };
 }
 
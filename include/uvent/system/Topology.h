@@ -0,0 +1,114 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_TOPOLOGY_H
+#define UVENT_TOPOLOGY_H
+
+#include <utility>
+#include <vector>
+
+namespace usub::uvent::system
+{
+    /// \brief How worker threads are placed on CPUs.
+    enum class PlacementPolicy
+    {
+        /// \brief Threads are not pinned, the OS scheduler places them.
+        NONE,
+        /// \brief Worker i is pinned to the i-th CPU the process is allowed to run on.
+        LINEAR,
+        /// \brief One worker per physical core first; SMT siblings are used only once every core has a worker.
+        PHYSICAL_CORES,
+        /// \brief Workers are split into contiguous groups, one per NUMA node, each bound to all allowed CPUs of its node.
+        NUMA_NODES,
+        /// \brief Worker i is pinned to `cpus[i % cpus.size()]`.
+        CPU_LIST
+    };
+
+    /**
+     * @brief Thread placement requested for a `Uvent` pool.
+     *
+     * The allowed CPU set is the process affinity mask, so cgroup cpusets and `isolcpus` are honoured
+     * by every policy except `CPU_LIST`, which uses the given CPUs as is.
+     */
+    struct ThreadPlacement
+    {
+        PlacementPolicy policy{PlacementPolicy::NONE};
+        std::vector<int> cpus;
+
+        static ThreadPlacement none() { return {PlacementPolicy::NONE, {}}; }
+        static ThreadPlacement linear() { return {PlacementPolicy::LINEAR, {}}; }
+        static ThreadPlacement physical_cores() { return {PlacementPolicy::PHYSICAL_CORES, {}}; }
+        static ThreadPlacement numa_nodes() { return {PlacementPolicy::NUMA_NODES, {}}; }
+        static ThreadPlacement cpu_list(std::vector<int> cpus) { return {PlacementPolicy::CPU_LIST, std::move(cpus)}; }
+
+        /// \brief `LINEAR` when the library is built with `UVENT_PIN_THREADS`, `NONE` otherwise.
+        static ThreadPlacement from_build()
+        {
+#ifdef UVENT_PIN_THREADS
+            return linear();
+#else
+            return none();
+#endif
+        }
+    };
+
+    namespace topology
+    {
+        struct CpuInfo
+        {
+            int cpu{-1};
+            int core{-1};
+            int package{-1};
+            int node{-1};
+        };
+
+        /// \brief CPUs a worker of a thread pool ends up on, and the NUMA node they belong to.
+        struct WorkerSlot
+        {
+            /// \brief Affinity set of the worker, empty if it is not pinned.
+            std::vector<int> cpus;
+            /// \brief NUMA node of the worker, -1 if unknown or if it is not pinned.
+            int node{-1};
+        };
+
+        /// \brief CPUs in the affinity mask of the calling thread, sorted by id. Empty where unsupported.
+        std::vector<CpuInfo> allowed_cpus();
+
+        /// \brief NUMA node of @p cpu, 0 on machines without NUMA information, -1 where unsupported.
+        int node_of_cpu(int cpu);
+
+        /// \brief Computes the slot of every worker of a pool of @p thread_count threads.
+        std::vector<WorkerSlot> plan(const ThreadPlacement& placement, int thread_count);
+
+        /// \brief Number of distinct NUMA nodes used by @p slots.
+        int node_count(const std::vector<WorkerSlot>& slots);
+
+        /// \brief Restricts the calling thread to @p cpus. Returns false on failure or if @p cpus is empty.
+        bool pin_current_thread(const std::vector<int>& cpus);
+
+        /**
+         * @brief Temporarily moves the calling thread to a set of CPUs.
+         *
+         * Memory first touched in its scope lands on the NUMA node of those CPUs. The previous affinity
+         * is restored on destruction. Does nothing for an empty set.
+         */
+        class ScopedAffinity
+        {
+        public:
+            explicit ScopedAffinity(const std::vector<int>& cpus);
+
+            ~ScopedAffinity();
+
+            ScopedAffinity(const ScopedAffinity&) = delete;
+
+            ScopedAffinity& operator=(const ScopedAffinity&) = delete;
+
+        private:
+            std::vector<int> saved_;
+            bool active_{false};
+        };
+    } // namespace topology
+} // namespace usub::uvent::system
+
+#endif // UVENT_TOPOLOGY_H
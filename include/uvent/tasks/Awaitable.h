@@ -35,14 +35,12 @@ namespace usub::uvent::task {
 
         Awaitable() = default;
 
-        virtual ~Awaitable() = default;
-
         [[nodiscard]] bool await_ready() const noexcept;
 
-        virtual Value await_resume();
+        Value await_resume();
 
         template <class U>
-        void await_suspend(std::coroutine_handle<U> h);
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<U> h);
 
         promise_type* get_promise();
 
@@ -68,16 +66,14 @@ namespace usub::uvent::task {
 
         Awaitable() = default;
 
-        virtual ~Awaitable() = default;
-
         [[nodiscard]] bool await_ready() const noexcept;
 
-        virtual void await_resume();
+        void await_resume();
 
         promise_type* get_promise();
 
         template <class U>
-        void await_suspend(std::coroutine_handle<U> h);
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<U> h);
 
         /// @brief Should be used carefully! Only for `get_return_object` in promise type.
         explicit Awaitable(promise_type* af);
@@ -88,11 +84,6 @@ namespace usub::uvent::task {
         promise_type* frame_{nullptr};
     };
 
-    template <class Value, class FrameType>
-    Value Awaitable<Value, FrameType>::await_resume() {
-        return this->frame_->get();
-    }
-
     template <class Value, class FrameType>
     bool Awaitable<Value, FrameType>::await_ready() const noexcept {
         return !frame_ || frame_->get_coroutine_handle().done();
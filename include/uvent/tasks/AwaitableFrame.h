@@ -6,14 +6,20 @@
 #define UVENT_AWAITABLEFRAME_H
 
 #include <atomic>
+#include <concepts>
 #include <coroutine>
 #include <memory>
 #include <new>
 #include <ranges>
+#include <type_traits>
+#include <utility>
 
 #include "Awaitable.h"
+#include "FramePool.h"
+#include "Priority.h"
 #include "uvent/base/Predefines.h"
 #include "uvent/utils/datastructures/queue/FastQueue.h"
+#include "uvent/utils/datastructures/queue/IntrusiveMPSCQueue.h"
 
 namespace usub::uvent {
     namespace detail {
@@ -27,47 +33,197 @@ namespace usub::uvent {
         template<class F>
         concept DeferredFrame = std::derived_from<no_cvr_t<F>, deferred_task_tag>;
 
-        class AwaitableFrameBase {
+        /// \brief Frames whose coroutine does not run before it is first resumed: `initial_suspend` always suspends.
+        template<class F>
+        concept LazyFrame =
+                std::same_as<decltype(std::declval<no_cvr_t<F> &>().initial_suspend()), std::suspend_always>;
+
+        /**
+         * @brief Common part of every promise type.
+         *
+         * Not polymorphic: frames are only ever reached through `std::coroutine_handle<AwaitableFrameBase>`
+         * and destroyed by their coroutine, which knows the concrete promise type. The handle of the frame
+         * is derived from the promise address instead of being stored. The intrusive link is used by the
+         * thread inboxes, so handing a frame to another thread allocates nothing.
+         */
+        class AwaitableFrameBase : public queue::concurrent::IntrusiveMPSCNode {
         public:
             template<class, class>
             friend class task::Awaitable;
 
             AwaitableFrameBase();
 
-            virtual ~AwaitableFrameBase() = default;
+            /// \brief Coroutine frames of every frame type come from the per-thread `FramePool`.
+            static void* operator new(std::size_t size) { return FramePool::allocate(size); }
 
-            virtual bool await_ready();
+            static void operator delete(void* p) noexcept { FramePool::deallocate(p); }
 
             void destroy(DestroyingPolicy policy = DEFAULT);
 
-            void set_calling_coroutine(std::coroutine_handle<> h);
-
-            void set_next_coroutine(std::coroutine_handle<> h);
+            /// \brief Records the coroutine awaiting this frame, see `final_transfer`.
+            template<class P>
+            void set_calling_coroutine(std::coroutine_handle<P> h) {
+                this->prev_ = h;
+                this->caller_is_frame_ = std::is_base_of_v<AwaitableFrameBase, P>;
+            }
 
+            /// \brief Coroutine awaiting this frame, null if there is none or the frame is joinable.
             std::coroutine_handle<> get_calling_coroutine();
 
-            std::coroutine_handle<> get_coroutine_handle();
-
-            std::coroutine_handle<> get_next_coroutine();
+            /// \brief Typed handle: runtime queues link and classify frames passed this way, see `wrap_foreign()`.
+            std::coroutine_handle<AwaitableFrameBase> get_coroutine_handle() {
+                return std::coroutine_handle<AwaitableFrameBase>::from_promise(*this);
+            }
 
             void resume();
 
             static void push_frame_into_task_queue(std::coroutine_handle<> h);
 
+            /**
+             * @brief Hands control to @p h from an `await_suspend`.
+             *
+             * Returns @p h for a direct (symmetric) transfer while the transfer budget of the current
+             * resume lasts; otherwise queues @p h like `push_frame_into_task_queue` and returns
+             * `std::noop_coroutine()`.
+             */
+            static std::coroutine_handle<> transfer_to(std::coroutine_handle<> h);
+
             void push_frame_to_be_destroyed();
 
+            /**
+             * @brief Completes the frame at its final suspend point and returns the coroutine to run next.
+             *
+             * An awaited frame transfers to its caller and is destroyed by the caller's `await_resume()`
+             * once the result is taken, or along with the caller if that is a runtime frame destroyed before
+             * it resumes (forced destruction, `stop()` with the caller still queued). A frame nobody awaits
+             * goes to `q_c`.
+             */
+            std::coroutine_handle<> final_transfer() noexcept;
+
+            /// \brief True once the frame has completed and its awaiter is responsible for destroying it.
+            [[nodiscard]] bool is_owned_by_awaiter() const { return this->owned_by_awaiter_; }
+
+            /**
+             * @brief Turns a frame that has not started yet into one joined through `task::JoinHandle`.
+             *
+             * A joinable frame does not transfer to a caller at its final suspend point. `prev_` becomes a
+             * small atomic state machine instead (running, waited on, completed, detached), so completion and
+             * the join race with a single atomic exchange and the result stays in the frame.
+             */
+            void join_start() noexcept;
+
+            /// \brief Joinable frame only: true once it has completed.
+            [[nodiscard]] bool join_done() noexcept;
+
+            /**
+             * @brief Joinable frame only: registers @p waiter to be resumed on completion.
+             *
+             * @p waiter is resumed on the calling worker.
+             * @return false if the frame has already completed, in which case @p waiter must not suspend.
+             */
+            bool join_wait(std::coroutine_handle<AwaitableFrameBase> waiter) noexcept;
+
+            /// \brief Joinable frame only: gives up the join. The frame is destroyed on completion, or now if completed.
+            void join_detach() noexcept;
+
             [[nodiscard]] int get_thread_id() const { return this->t_id_; }
 
             [[nodiscard]] int get_thread_id() { return this->t_id_; }
 
             void set_thread_id(int t_id) { this->t_id_ = t_id; }
 
+            [[nodiscard]] task::Priority get_priority() const { return this->priority_; }
+
+            void set_priority(task::Priority priority) { this->priority_ = priority; }
+
         protected:
+            ~AwaitableFrameBase();
+
             std::exception_ptr exception_{nullptr};
-            std::coroutine_handle<> coro_{nullptr};
             std::coroutine_handle<> prev_{nullptr};
-            std::coroutine_handle<> next_{nullptr};
             int t_id_{0};
+            task::Priority priority_{task::Priority::NORMAL};
+            bool owned_by_awaiter_{false};
+            bool joinable_{false};
+            bool caller_is_frame_{false};
+            /// \brief Completed frame handed to this one at its final suspend point, until `await_resume()` reaps it.
+            AwaitableFrameBase* owned_child_{nullptr};
+
+        private:
+            std::coroutine_handle<> final_join() noexcept;
+        };
+
+        /**
+         * @brief Wraps a coroutine that may not be a runtime frame into one that resumes it once.
+         *
+         * Inboxes link their tasks through the `AwaitableFrameBase` of the frame and run queues read its
+         * priority class, so a bare `std::coroutine_handle<>` cannot be queued as is: it may belong to a
+         * coroutine with any promise type. The wrapper is a regular frame from `FramePool`; it resumes
+         * @p h when it runs and completes as soon as @p h suspends or finishes, in class @p priority.
+         */
+        std::coroutine_handle<AwaitableFrameBase> wrap_foreign(std::coroutine_handle<> h,
+                                                               task::Priority priority = task::Priority::NORMAL);
+
+        /**
+         * @brief A suspended coroutine that may be woken from another thread.
+         *
+         * Built from the typed handle an awaiter's `await_suspend` receives, so it knows whether the
+         * promise is a runtime frame. A runtime frame is linked into the target's inbox as it is; any
+         * other coroutine goes through `wrap_foreign()` when it is woken, never before.
+         */
+        class WakeHandle {
+        public:
+            WakeHandle() noexcept = default;
+
+            template<class P>
+            WakeHandle(std::coroutine_handle<P> h) noexcept : is_frame_(std::is_base_of_v<AwaitableFrameBase, P>) {
+                if constexpr (std::is_base_of_v<AwaitableFrameBase, P>)
+                    this->h_ = std::coroutine_handle<AwaitableFrameBase>::from_promise(h.promise());
+                else
+                    this->h_ = h;
+            }
+
+            explicit operator bool() const noexcept { return static_cast<bool>(this->h_); }
+
+            /// \brief The coroutine itself, for a run queue of the calling thread.
+            [[nodiscard]] std::coroutine_handle<> handle() const noexcept { return this->h_; }
+
+            /// \brief Frame to hand to another thread's queues, carrying class @p priority.
+            [[nodiscard]] std::coroutine_handle<AwaitableFrameBase> to_frame(task::Priority priority) const {
+                if (!this->is_frame_)
+                    return wrap_foreign(this->h_, priority);
+                // the coroutine is suspended and owned by the waker until it is queued
+                const auto frame = std::coroutine_handle<AwaitableFrameBase>::from_address(this->h_.address());
+                frame.promise().set_priority(priority);
+                return frame;
+            }
+
+        private:
+            std::coroutine_handle<> h_{nullptr};
+            bool is_frame_{false};
+        };
+
+        /// \brief Final suspend awaiter of the built-in frames, see `AwaitableFrameBase::final_transfer`.
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+
+            template<class P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+                return h.promise().final_transfer();
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        /// \brief Destroys a completed frame handed to its awaiter, after the result has been taken.
+        template<class FrameType>
+        struct FrameReaper {
+            FrameType *frame;
+
+            ~FrameReaper() {
+                if (this->frame) this->frame->destroy();
+            }
         };
 
         template<class T>
@@ -75,13 +231,12 @@ namespace usub::uvent {
         public:
             AwaitableFrame() noexcept = default;
 
-            ~AwaitableFrame() override;
+            ~AwaitableFrame();
 
             void unhandled_exception() { this->exception_ = std::current_exception(); }
 
             auto get_return_object() {
                 using selt_t = std::remove_reference_t<decltype(*this)>;
-                this->coro_ = std::coroutine_handle<AwaitableFrame>::from_promise(*this);
                 return task::Awaitable<T, selt_t>{this};
             }
 
@@ -97,7 +252,7 @@ namespace usub::uvent {
 
             std::suspend_always initial_suspend() noexcept;
 
-            std::suspend_always final_suspend() noexcept;
+            FinalAwaiter final_suspend() noexcept;
 
             std::suspend_always yield_value(T value) noexcept;
 
@@ -111,12 +266,10 @@ namespace usub::uvent {
         public:
             AwaitableFrame() noexcept = default;
 
-            ~AwaitableFrame() override;
+            ~AwaitableFrame();
 
             auto get_return_object() {
                 using self_t = std::remove_reference_t<decltype(*this)>;
-
-                this->coro_ = std::coroutine_handle<AwaitableFrame>::from_promise(*this);
                 return task::Awaitable<void, self_t>{this};
             }
 
@@ -131,7 +284,7 @@ namespace usub::uvent {
 
             std::suspend_always initial_suspend() noexcept;
 
-            std::suspend_always final_suspend() noexcept;
+            FinalAwaiter final_suspend() noexcept;
 
             std::suspend_always yield_value() noexcept;
         };
@@ -141,13 +294,12 @@ namespace usub::uvent {
         public:
             AwaitableIOFrame() noexcept = default;
 
-            ~AwaitableIOFrame() override;
+            ~AwaitableIOFrame();
 
             void unhandled_exception() { this->exception_ = std::current_exception(); }
 
             auto get_return_object() {
                 using selt_t = std::remove_reference_t<decltype(*this)>;
-                this->coro_ = std::coroutine_handle<AwaitableIOFrame>::from_promise(*this);
                 return task::Awaitable<T, selt_t>{this};
             }
 
@@ -163,7 +315,7 @@ namespace usub::uvent {
 
             std::suspend_never initial_suspend() noexcept;
 
-            std::suspend_always final_suspend() noexcept;
+            FinalAwaiter final_suspend() noexcept;
 
         private:
             bool has_result_ = false;
@@ -171,18 +323,10 @@ namespace usub::uvent {
         };
 
         template<typename T>
-        std::suspend_always AwaitableIOFrame<T>::final_suspend() noexcept {
+        FinalAwaiter AwaitableIOFrame<T>::final_suspend() noexcept {
 #if UVENT_DEBUG
-            spdlog::trace("Entering final_suspend for coroutine {}", this->coro_.address());
+            spdlog::trace("Entering final_suspend for coroutine {}", this->get_coroutine_handle().address());
 #endif
-            if (this->prev_) {
-                auto prev = std::exchange(this->prev_, nullptr);
-                auto parent =
-                        std::coroutine_handle<AwaitableFrameBase>::from_address(prev.address());
-                AwaitableFrameBase::push_frame_into_task_queue(
-                    static_cast<std::coroutine_handle<>>(parent));
-            }
-            this->push_frame_to_be_destroyed();
             return {};
         }
 
@@ -197,17 +341,10 @@ namespace usub::uvent {
         }
 
         template<class T>
-        std::suspend_always AwaitableFrame<T>::final_suspend() noexcept {
+        FinalAwaiter AwaitableFrame<T>::final_suspend() noexcept {
 #if UVENT_DEBUG
-            spdlog::trace("Entering final_suspend for coroutine {}", this->coro_.address());
+            spdlog::trace("Entering final_suspend for coroutine {}", this->get_coroutine_handle().address());
 #endif
-            if (this->prev_) {
-                auto c_temp =
-                        std::coroutine_handle<::usub::uvent::detail::AwaitableFrameBase>::from_address(
-                            std::exchange(this->prev_, nullptr).address());
-                push_frame_into_task_queue(static_cast<std::coroutine_handle<>>(c_temp));
-            }
-            this->push_frame_to_be_destroyed();
             return {};
         }
 
@@ -216,7 +353,8 @@ namespace usub::uvent {
             new(&this->result_) T(std::move(value));
             this->has_result_ = true;
 
-            if (this->prev_) {
+            // a joinable frame has no caller: its prev_ holds the join state
+            if (!this->joinable_ && this->prev_) {
                 auto parent =
                         std::coroutine_handle<::usub::uvent::detail::AwaitableFrameBase>::from_address(
                             this->prev_.address());
@@ -228,7 +366,7 @@ namespace usub::uvent {
         template<class T>
         AwaitableFrame<T>::~AwaitableFrame() {
 #if UVENT_DEBUG
-            spdlog::trace("Destroying coroutine {}", this->coro_.address());
+            spdlog::trace("Destroying coroutine {}", this->get_coroutine_handle().address());
 #endif
             if (this->has_result_) std::launder(reinterpret_cast<T *>(&this->result_))->~T();
         }
@@ -236,7 +374,7 @@ namespace usub::uvent {
         template<class T>
         AwaitableIOFrame<T>::~AwaitableIOFrame() {
 #if UVENT_DEBUG
-            spdlog::info("Destroying coroutine IO {}", this->coro_.address());
+            spdlog::info("Destroying coroutine IO {}", this->get_coroutine_handle().address());
 #endif
             if (this->has_result_) std::launder(reinterpret_cast<T *>(&this->result_))->~T();
         }
@@ -250,42 +388,44 @@ namespace usub::uvent {
     namespace task {
         template<class FrameType>
         template<class U>
-        void Awaitable<void, FrameType>::await_suspend(std::coroutine_handle<U> h) {
-            auto ph = std::coroutine_handle<detail::AwaitableFrameBase>::from_address(h.address());
-            auto &p = ph.promise();
-
+        std::coroutine_handle<> Awaitable<void, FrameType>::await_suspend(std::coroutine_handle<U> h) {
             auto child = this->frame_->get_coroutine_handle();
-            p.set_next_coroutine(child);
             this->frame_->set_calling_coroutine(h);
 
             if constexpr (!detail::DeferredFrame<FrameType>) {
                 if (child && !child.done())
-                    detail::AwaitableFrameBase::push_frame_into_task_queue(
-                        static_cast<std::coroutine_handle<>>(child));
+                    return detail::AwaitableFrameBase::transfer_to(child);
             }
+            return std::noop_coroutine();
         }
 
         template<class Value, class FrameType>
         template<class U>
-        void Awaitable<Value, FrameType>::await_suspend(std::coroutine_handle<U> h) {
-            auto &p = std::coroutine_handle<detail::AwaitableFrameBase>::from_address(h.address())
-                    .promise();
-
+        std::coroutine_handle<> Awaitable<Value, FrameType>::await_suspend(std::coroutine_handle<U> h) {
             auto child = this->frame_->get_coroutine_handle();
-            p.set_next_coroutine(child);
             this->frame_->set_calling_coroutine(h);
 
             if constexpr (!detail::DeferredFrame<FrameType>) {
-                if (child && !child.done()) {
-                    detail::AwaitableFrameBase::push_frame_into_task_queue(
-                        static_cast<std::coroutine_handle<>>(child));
-                }
+                if (child && !child.done())
+                    return detail::AwaitableFrameBase::transfer_to(child);
             }
+            return std::noop_coroutine();
+        }
+
+        template<class Value, class FrameType>
+        Value Awaitable<Value, FrameType>::await_resume() {
+            detail::FrameReaper<FrameType> reaper{
+                this->frame_->is_owned_by_awaiter() ? std::exchange(this->frame_, nullptr) : nullptr
+            };
+            return (reaper.frame ? reaper.frame : this->frame_)->get();
         }
 
         template<class FrameType>
         void Awaitable<void, FrameType>::await_resume() {
-            this->frame_->get();
+            detail::FrameReaper<FrameType> reaper{
+                this->frame_->is_owned_by_awaiter() ? std::exchange(this->frame_, nullptr) : nullptr
+            };
+            (reaper.frame ? reaper.frame : this->frame_)->get();
         }
 
         template<class FrameType>
@@ -0,0 +1,89 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_FRAMEPOOL_H
+#define UVENT_FRAMEPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace usub::uvent::detail
+{
+    /**
+     * @brief Per-thread size-class allocator for coroutine frames.
+     *
+     * Frames up to `MAX_POOLED_SIZE` bytes are carved from per-thread free lists, one list per
+     * `GRANULARITY`-byte size class. A frame freed on the thread that allocated it goes straight back to
+     * that thread's list; a frame freed elsewhere is pushed onto the owner's lock-free remote-free stack,
+     * which the owner drains when its own list runs dry. Larger frames go to the global allocator.
+     */
+    class FramePool
+    {
+    public:
+        static constexpr size_t GRANULARITY = 64;
+        static constexpr size_t MAX_POOLED_SIZE = 2048;
+        static constexpr size_t CLASS_COUNT = MAX_POOLED_SIZE / GRANULARITY;
+
+        static void* allocate(size_t size);
+
+        static void deallocate(void* p) noexcept;
+
+        /// \brief Pool of the calling thread, created on first use.
+        static FramePool& local();
+
+        /**
+         * @brief Releases the cached blocks when the owning thread exits.
+         *
+         * Blocks it handed out may still be alive on other threads; they are returned to the global
+         * allocator from then on, and the pool object is deleted together with the last of them.
+         */
+        void retire() noexcept;
+
+    private:
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        /// \brief Prepended to every block, keeps the user pointer 16-byte aligned.
+        struct alignas(16) BlockHeader
+        {
+            FramePool* owner;
+            uint32_t size_class;
+        };
+
+        static constexpr uint32_t UNPOOLED = UINT32_MAX;
+
+        FramePool() = default;
+
+        void* allocate_local(uint32_t size_class);
+
+        void free_local(BlockHeader* block) noexcept;
+
+        void free_remote(BlockHeader* block) noexcept;
+
+        /// \brief Moves blocks freed by other threads into the local lists.
+        void drain_remote() noexcept;
+
+        /// \brief Returns a block to the global allocator, and deletes a retired pool with its last block.
+        void release_block(BlockHeader* block) noexcept;
+
+        static size_t class_bytes(uint32_t size_class) noexcept
+        {
+            return (static_cast<size_t>(size_class) + 1) * GRANULARITY;
+        }
+
+        FreeNode* free_[CLASS_COUNT]{};
+        uint32_t cached_[CLASS_COUNT]{};
+        std::atomic<FreeNode*> remote_{nullptr};
+        /// \brief Blocks taken from the global allocator and not given back, plus one held by the owner until `retire()`.
+        std::atomic<size_t> blocks_{1};
+
+        /// \brief Stored in `remote_` by `retire()`.
+        static FreeNode CLOSED;
+    };
+} // namespace usub::uvent::detail
+
+#endif // UVENT_FRAMEPOOL_H
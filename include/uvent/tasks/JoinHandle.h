@@ -0,0 +1,137 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_JOINHANDLE_H
+#define UVENT_JOINHANDLE_H
+
+#include <concepts>
+#include <coroutine>
+#include <utility>
+
+#include "uvent/system/SystemContext.h"
+#include "uvent/tasks/AwaitableFrame.h"
+
+namespace usub::uvent::task
+{
+    /**
+     * @brief Owning handle of a coroutine started by `system::co_spawn_joinable()`; awaiting it yields its result.
+     *
+     * The result (or exception) stays in the child's frame. Completion and the join meet on one atomic
+     * exchange of the frame's state, so joining costs no channel and no allocation. The handle can be
+     * awaited once, from a runtime coroutine (`task::Awaitable`; other promise types do not compile);
+     * the waiter resumes on the worker it suspended on. Only lazily started frames can be joined: an
+     * eager frame may already have completed before its join state exists. Dropping the handle without
+     * awaiting detaches the child, which then runs to completion and is destroyed like a `co_spawn`ed
+     * coroutine.
+     */
+    template <class Value, class FrameType = detail::AwaitableFrame<Value>>
+    class JoinHandle
+    {
+        static_assert(detail::LazyFrame<FrameType> && !detail::DeferredFrame<FrameType>,
+                      "only lazily started frames can be joined");
+
+    public:
+        JoinHandle() noexcept = default;
+
+        explicit JoinHandle(FrameType* frame) noexcept : frame_(frame) {}
+
+        JoinHandle(JoinHandle&& o) noexcept : frame_(std::exchange(o.frame_, nullptr)) {}
+
+        JoinHandle& operator=(JoinHandle&& o) noexcept
+        {
+            if (this != &o)
+            {
+                this->detach();
+                this->frame_ = std::exchange(o.frame_, nullptr);
+            }
+            return *this;
+        }
+
+        JoinHandle(const JoinHandle&) = delete;
+
+        JoinHandle& operator=(const JoinHandle&) = delete;
+
+        ~JoinHandle() { this->detach(); }
+
+        /// \brief Lets the child finish on its own; its result is discarded.
+        void detach() noexcept
+        {
+            if (auto* frame = std::exchange(this->frame_, nullptr))
+                frame->join_detach();
+        }
+
+        /// \brief True if the child has completed. False for an empty handle.
+        [[nodiscard]] bool done() const noexcept { return this->frame_ && this->frame_->join_done(); }
+
+        [[nodiscard]] bool valid() const noexcept { return this->frame_ != nullptr; }
+
+        bool await_ready() const noexcept { return this->done(); }
+
+        template <class P>
+            requires std::derived_from<P, detail::AwaitableFrameBase>
+        bool await_suspend(std::coroutine_handle<P> h) noexcept
+        {
+            return this->frame_->join_wait(std::coroutine_handle<detail::AwaitableFrameBase>::from_promise(h.promise()));
+        }
+
+        /// \return the child's result; rethrows the exception it exited with.
+        Value await_resume()
+        {
+            detail::FrameReaper<FrameType> reaper{std::exchange(this->frame_, nullptr)};
+            return reaper.frame->get();
+        }
+
+    private:
+        FrameType* frame_{nullptr};
+    };
+} // namespace usub::uvent::task
+
+namespace usub::uvent::system
+{
+    /**
+     * @brief Spawns a coroutine like `co_spawn(f)` and returns a handle to await its result.
+     *
+     * @code
+     * auto h = system::co_spawn_joinable(compute(shard));
+     * // ... other work ...
+     * int v = co_await h;
+     * @endcode
+     *
+     * @tparam Value Result type of the coroutine.
+     * @param f Lazily started coroutine (`task::Awaitable<Value>`) that has not been started or awaited yet.
+     *          Eager frames such as `AwaitableIOFrame` are rejected: they may complete before `join_start()`.
+     */
+    template <class Value, class FrameType>
+        requires detail::LazyFrame<FrameType>
+    [[nodiscard]] task::JoinHandle<Value, FrameType> co_spawn_joinable(task::Awaitable<Value, FrameType> f)
+    {
+        auto* promise = f.get_promise();
+        if (!promise)
+            return {};
+        // before the spawn: the child may complete on another worker right away
+        promise->join_start();
+        co_spawn(promise->get_coroutine_handle());
+        return task::JoinHandle<Value, FrameType>{promise};
+    }
+
+    /**
+     * @brief Enqueues a coroutine into the inbox of a specific thread and returns a handle to await its result.
+     *
+     * Same as `co_spawn_static(f, threadIndex)` otherwise, see `co_spawn_joinable(f)`.
+     */
+    template <class Value, class FrameType>
+        requires detail::LazyFrame<FrameType>
+    [[nodiscard]] task::JoinHandle<Value, FrameType> co_spawn_joinable(task::Awaitable<Value, FrameType> f,
+                                                                       int threadIndex)
+    {
+        auto* promise = f.get_promise();
+        if (!promise)
+            return {};
+        promise->join_start();
+        global::detail::tls_registry->getStorage(threadIndex)->push_task_inbox(promise->get_coroutine_handle());
+        return task::JoinHandle<Value, FrameType>{promise};
+    }
+} // namespace usub::uvent::system
+
+#endif // UVENT_JOINHANDLE_H
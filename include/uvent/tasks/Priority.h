@@ -0,0 +1,31 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_PRIORITY_H
+#define UVENT_PRIORITY_H
+
+#include <cstdint>
+
+namespace usub::uvent::task
+{
+    /**
+     * @brief Scheduling class of a coroutine.
+     *
+     * The class is stored in the coroutine frame and inherited by coroutines created while it runs.
+     * Wake-up sites record it next to the waiting handle when the coroutine suspends, so workers
+     * never read it from a ready frame. Each worker keeps a separate run queue per class:
+     *  - `LATENCY_CRITICAL` tasks are resumed before any other ready task (strict priority);
+     *  - `NORMAL` is the default class;
+     *  - `BACKGROUND` tasks are resumed only after the other classes are drained, at most
+     *    `settings::max_background_tasks_per_iteration` per loop iteration.
+     */
+    enum class Priority : uint8_t
+    {
+        LATENCY_CRITICAL = 0,
+        NORMAL = 1,
+        BACKGROUND = 2
+    };
+} // namespace usub::uvent::task
+
+#endif // UVENT_PRIORITY_H
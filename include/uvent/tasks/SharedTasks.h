@@ -6,12 +6,21 @@
 #define UVENT_SHAREDTASKS_H
 
 #include <mutex>
+#include <deque>
 #include <memory>
 #include "Awaitable.h"
 #include "uvent/utils/datastructures/queue/ConcurrentQueues.h"
 #include "uvent/utils/datastructures/queue/FastQueue.h"
 
 namespace usub::uvent::task {
+    /**
+     * @brief Global task queue shared by all worker threads.
+     *
+     * Backed by a bounded lock-free ring. When the ring is full, `enqueue()` spills into a
+     * mutex-protected overflow list instead of dropping the task, so bursts larger than the
+     * ring capacity degrade into a slower path rather than leaking coroutine frames.
+     * `try_enqueue()` never spills and reports a full ring to the caller (backpressure).
+     */
     class SharedTasks {
     public:
         SharedTasks();
@@ -22,16 +31,31 @@ namespace usub::uvent::task {
 
         void enqueue(std::coroutine_handle<> &&task);
 
+        /// \brief Enqueues @p n tasks, claiming ring cells in bulk; what does not fit goes to the overflow list at once.
+        void enqueue_bulk(const std::coroutine_handle<> *tasks, size_t n);
+
+        /// \brief Enqueues only if the lock-free ring has room and nothing is waiting in the overflow list.
+        [[nodiscard]] bool try_enqueue(std::coroutine_handle<> task);
+
         bool dequeue(std::coroutine_handle<> &task);
 
         bool dequeue(std::coroutine_handle<> &&task);
 
-        bool dequeue_bulk(queue::single_thread::Queue<std::coroutine_handle<>>* q);
+        /// \brief Takes up to @p max_items tasks, from the ring first and then from the overflow list.
+        size_t dequeue_bulk(std::coroutine_handle<>* out, size_t max_items);
 
         std::size_t getSize();
 
+    private:
+        void push_overflow(std::coroutine_handle<> task);
+
+        size_t pop_overflow(std::coroutine_handle<>* out, size_t max_items);
+
     private:
         std::unique_ptr<queue::concurrent::MPMCQueue<std::coroutine_handle<>>> detachedTasks;
+        std::mutex overflow_mtx_;
+        std::deque<std::coroutine_handle<>> overflow_;
+        std::atomic<size_t> overflow_size_{0};
     };
 }
 
@@ -164,43 +164,44 @@ namespace usub::queue::concurrent
         bool try_enqueue(const T& v) { return do_enqueue([&](void* p) { new(p) T(v); }); }
         bool try_enqueue(T&& v) { return do_enqueue([&](void* p) { new(p) T(std::move(v)); }); }
 
+        /**
+         * @brief Enqueues up to @p n items with a single claim of the producer position.
+         *
+         * Only cells already released by consumers are claimed, so a successful claim never leaves
+         * a hole in the queue. @return Number of items enqueued, from the front of @p in.
+         */
         size_t try_enqueue_bulk(const T* in, size_t n)
         {
             if (n == 0) return 0;
             size_t start = this->enq_pos_.load(std::memory_order_relaxed);
             for (;;)
             {
-                Cell& c0 = this->cells_[start & this->mask_];
-                size_t seq0 = c0.seq.load(std::memory_order_acquire);
-                if ((intptr_t)seq0 - (intptr_t)start < 0) return 0;
+                // free cells can only be taken by a producer that moves enq_pos_ past them
+                size_t k = 0;
+                while (k < n && this->cells_[(start + k) & this->mask_].seq.load(std::memory_order_acquire) ==
+                                    start + k)
+                    ++k;
+                if (k == 0)
+                {
+                    const size_t cur = this->enq_pos_.load(std::memory_order_relaxed);
+                    if (cur == start) return 0; // full
+                    start = cur;
+                    continue;
+                }
 
-                size_t end = start + n;
-                if (this->enq_pos_.compare_exchange_weak(start, end, std::memory_order_acq_rel,
+                if (this->enq_pos_.compare_exchange_weak(start, start + k, std::memory_order_acq_rel,
                                                          std::memory_order_relaxed))
                 {
-                    size_t taken = 0;
-                    for (size_t pos = start; pos < end; ++pos)
+                    for (size_t i = 0; i < k; ++i)
                     {
-                        Cell& c = this->cells_[pos & this->mask_];
-                        size_t seq = c.seq.load(std::memory_order_acquire);
-                        if ((intptr_t)seq - (intptr_t)pos != 0) break;
-
-                        prefetch_for_write(&this->cells_[(pos + 16) & this->mask_]);
+                        Cell& c = this->cells_[(start + i) & this->mask_];
                         void* p = static_cast<void*>(std::launder(reinterpret_cast<T*>(&c.storage)));
-                        new(p) T(in[taken]);
-                        c.seq.store(pos + 1, std::memory_order_release);
-                        ++taken;
+                        new(p) T(in[i]);
+                        c.seq.store(start + i + 1, std::memory_order_release);
                     }
-                    if (taken < n)
-                    {
-                        size_t expect = end;
-                        this->enq_pos_.compare_exchange_strong(expect, start + taken, std::memory_order_acq_rel,
-                                                               std::memory_order_relaxed);
-                    }
-                    return taken;
+                    return k;
                 }
                 cpu_relax();
-                start = this->enq_pos_.load(std::memory_order_relaxed);
             }
         }
 
@@ -372,6 +373,122 @@ namespace usub::queue::concurrent
         char _pad0_[data_structures::metadata::CACHELINE_SIZE - sizeof(std::atomic<size_t>)]{};
         char _pad1_[data_structures::metadata::CACHELINE_SIZE - sizeof(std::atomic<size_t>)]{};
     };
+
+    /**
+     * @brief Bounded single-producer / multi-consumer run queue used for work stealing.
+     *
+     * Only the owning thread pushes (at the tail). The owner and any number of thieves
+     * take from the head by CAS, so a thief can grab a whole batch in one atomic step.
+     * Items are plain values (coroutine handles), slots are overwritten in place.
+     */
+    template <typename T>
+    class alignas(data_structures::metadata::CACHELINE_SIZE) WorkStealingQueue
+    {
+    private:
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+    public:
+        explicit WorkStealingQueue(size_t capacity_pow2 = 256) :
+            cap_(next_pow2(capacity_pow2)), mask_(cap_ - 1),
+            slots_(static_cast<std::atomic<T>*>(
+                ::operator new[](cap_ * sizeof(std::atomic<T>), std::align_val_t(alignof(std::atomic<T>)))))
+        {
+            for (size_t i = 0; i < this->cap_; ++i)
+                new(&this->slots_[i]) std::atomic<T>(T{});
+        }
+
+        ~WorkStealingQueue()
+        {
+            for (size_t i = 0; i < this->cap_; ++i)
+                this->slots_[i].~atomic();
+
+            ::operator delete[](this->slots_, std::align_val_t(alignof(std::atomic<T>)));
+        }
+
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+        WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+        /// \brief Owner only. Returns false if the queue is full.
+        bool try_push(const T& v)
+        {
+            const size_t tail = this->tail_.load(std::memory_order_relaxed);
+            if (tail - this->head_.load(std::memory_order_acquire) >= this->cap_) return false; // full
+
+            this->slots_[tail & this->mask_].store(v, std::memory_order_relaxed);
+            this->tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// \brief Owner only. Pushes as many items as fit and returns their count.
+        size_t try_push_bulk(const T* in, size_t n)
+        {
+            const size_t tail = this->tail_.load(std::memory_order_relaxed);
+            const size_t used = tail - this->head_.load(std::memory_order_acquire);
+            const size_t free = used >= this->cap_ ? 0 : this->cap_ - used;
+            if (n > free) n = free;
+            if (n == 0) return 0;
+
+            for (size_t i = 0; i < n; ++i)
+                this->slots_[(tail + i) & this->mask_].store(in[i], std::memory_order_relaxed);
+            this->tail_.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        /// \brief Owner side. Takes up to max_items from the head.
+        size_t try_pop_bulk(T* out, size_t max_items) { return take(out, max_items, false); }
+
+        /// \brief Thief side. Takes half of the available items (at least one), up to max_items.
+        size_t steal_half(T* out, size_t max_items) { return take(out, max_items, true); }
+
+        bool empty_relaxed() const noexcept
+        {
+            return this->tail_.load(std::memory_order_relaxed) == this->head_.load(std::memory_order_relaxed);
+        }
+
+        size_t size_relaxed() const noexcept
+        {
+            const size_t h = this->head_.load(std::memory_order_relaxed);
+            const size_t t = this->tail_.load(std::memory_order_relaxed);
+            return t > h ? t - h : 0;
+        }
+
+        size_t capacity() const noexcept { return this->cap_; }
+
+    private:
+        size_t take(T* out, size_t max_items, bool half)
+        {
+            if (max_items == 0) return 0;
+
+            size_t head = this->head_.load(std::memory_order_acquire);
+            for (;;)
+            {
+                const size_t tail = this->tail_.load(std::memory_order_acquire);
+                if (tail <= head) return 0; // empty
+
+                size_t n = tail - head;
+                if (half) n -= n / 2;
+                if (n > max_items) n = max_items;
+
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = this->slots_[(head + i) & this->mask_].load(std::memory_order_relaxed);
+
+                // slots can only be reused after head moves past them, so a successful CAS
+                // proves that everything read above is still valid
+                if (this->head_.compare_exchange_weak(head, head + n, std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+                    return n;
+                cpu_relax();
+            }
+        }
+
+        const size_t cap_;
+        const size_t mask_;
+        std::atomic<T>* slots_;
+
+        alignas(data_structures::metadata::CACHELINE_SIZE) std::atomic<size_t> head_{0};
+        alignas(data_structures::metadata::CACHELINE_SIZE) std::atomic<size_t> tail_{0};
+        char _pad_[data_structures::metadata::CACHELINE_SIZE - sizeof(std::atomic<size_t>)]{};
+    };
 }
 
 #endif //MPMCQUEUE_H
@@ -0,0 +1,99 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_INTRUSIVEMPSCQUEUE_H
+#define UVENT_INTRUSIVEMPSCQUEUE_H
+
+#include <atomic>
+
+#include "uvent/utils/datastructures/DataStructuresMetadata.h"
+
+namespace usub::queue::concurrent
+{
+    /// \brief Link embedded in the elements of an `IntrusiveMPSCQueue`.
+    struct IntrusiveMPSCNode
+    {
+        std::atomic<IntrusiveMPSCNode*> mpsc_next_{nullptr};
+    };
+
+    /**
+     * @brief Unbounded intrusive multi-producer single-consumer queue (Vyukov).
+     *
+     * `T` derives from `IntrusiveMPSCNode`; an element may be in at most one such queue at a time.
+     * A push is one exchange and one store, never allocates and never fails. Only one thread may pop.
+     *
+     * A producer that has swapped the head but not linked its element yet hides it and everything
+     * pushed after it: `pop()` returns nullptr until the link is published, while `empty()` already
+     * reports false.
+     */
+    template <class T>
+    class IntrusiveMPSCQueue
+    {
+    public:
+        IntrusiveMPSCQueue() noexcept : head_(&stub_), tail_(&stub_) {}
+
+        IntrusiveMPSCQueue(const IntrusiveMPSCQueue&) = delete;
+
+        IntrusiveMPSCQueue& operator=(const IntrusiveMPSCQueue&) = delete;
+
+        void push(T* item) noexcept { this->push_node(item, item); }
+
+        /// \brief Chains @p b after @p a, to build the list passed to `push_chain()`.
+        static void link(T* a, T* b) noexcept { static_cast<IntrusiveMPSCNode*>(a)->mpsc_next_.store(b, std::memory_order_relaxed); }
+
+        /// \brief Pushes the elements chained from @p first to @p last with `link()` in one step.
+        void push_chain(T* first, T* last) noexcept { this->push_node(first, last); }
+
+        T* pop() noexcept
+        {
+            IntrusiveMPSCNode* tail = this->tail_;
+            IntrusiveMPSCNode* next = tail->mpsc_next_.load(std::memory_order_acquire);
+            if (tail == &this->stub_)
+            {
+                if (!next)
+                    return nullptr;
+                this->tail_ = next;
+                tail = next;
+                next = next->mpsc_next_.load(std::memory_order_acquire);
+            }
+            if (next)
+            {
+                this->tail_ = next;
+                return static_cast<T*>(tail);
+            }
+            if (tail != this->head_.load(std::memory_order_acquire))
+                return nullptr; // a producer is between its exchange and its link
+
+            // tail is the last element: put the stub behind it so it can be handed out
+            this->push_node(&this->stub_, &this->stub_);
+            next = tail->mpsc_next_.load(std::memory_order_acquire);
+            if (next)
+            {
+                this->tail_ = next;
+                return static_cast<T*>(tail);
+            }
+            return nullptr;
+        }
+
+        /// \brief Consumer side only.
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return this->tail_ == &this->stub_ && this->head_.load(std::memory_order_acquire) == &this->stub_;
+        }
+
+    private:
+        void push_node(IntrusiveMPSCNode* first, IntrusiveMPSCNode* last) noexcept
+        {
+            last->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+            IntrusiveMPSCNode* prev = this->head_.exchange(last, std::memory_order_acq_rel);
+            prev->mpsc_next_.store(first, std::memory_order_release);
+        }
+
+        alignas(data_structures::metadata::CACHELINE_SIZE) std::atomic<IntrusiveMPSCNode*> head_;
+        alignas(data_structures::metadata::CACHELINE_SIZE) IntrusiveMPSCNode* tail_;
+        IntrusiveMPSCNode stub_;
+    };
+} // namespace usub::queue::concurrent
+
+#endif // UVENT_INTRUSIVEMPSCQUEUE_H
@@ -55,10 +55,12 @@ namespace usub::uvent::utils
 
             auto* p = aw.get_promise();
             this->coro = p->get_coroutine_handle();
+            this->priority = p->get_priority();
             this->active = true;
         }
 
-        void bind(std::coroutine_handle<> h) noexcept;
+        /// \brief Resumes @p h in class @p priority when the timer fires.
+        void bind(std::coroutine_handle<> h, task::Priority priority = task::Priority::NORMAL) noexcept;
 
     public:
         timeout_t expiryTime;
@@ -66,6 +68,7 @@ namespace usub::uvent::utils
 
     private:
         std::coroutine_handle<> coro;
+        task::Priority priority{task::Priority::NORMAL};
         bool active;
         uint64_t id;
         size_t slotIndex{0};
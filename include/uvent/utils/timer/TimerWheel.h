@@ -44,7 +44,8 @@ namespace usub::uvent::utils
 
         bool removeTimer(uint64_t timerId);
 
-        void tick();
+        /// \brief Applies pending timer operations and fires due timers. Returns the number of timers fired.
+        size_t tick();
 
         int getNextTimeout() const;
 
@@ -66,7 +67,7 @@ namespace usub::uvent::utils
 
         void removeTimerFromWheel(Timer* timer);
 
-        void advance();
+        size_t advance();
 
         void updateNextExpiryTime();
 
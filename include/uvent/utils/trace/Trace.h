@@ -0,0 +1,131 @@
+//
+// Created by root on 10/16/26.
+//
+
+#ifndef UVENT_TRACE_H
+#define UVENT_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace usub::uvent::utils::trace
+{
+    enum class EventType : uint8_t
+    {
+        /// \brief A coroutine ran on a worker (complete event).
+        RESUME,
+        /// \brief A poller call (complete event), arg is the timeout in ms.
+        POLL,
+        /// \brief A timer expired and woke a coroutine (instant event), arg is the timer id.
+        TIMER_FIRE,
+        /// \brief The poller made a coroutine runnable (instant event), arg is the file descriptor.
+        IO_READY
+    };
+
+    struct Event
+    {
+        uint64_t ts_ns;
+        uint64_t dur_ns;
+        const void* subject;
+        int64_t arg;
+        EventType type;
+    };
+
+    /**
+     * @brief Fixed-size ring of trace events written by a single thread.
+     *
+     * Writing never blocks and never allocates; once full, the oldest events are overwritten.
+     */
+    class TraceBuffer
+    {
+    public:
+        TraceBuffer(int tid, size_t capacity);
+
+        void push(const Event& e) noexcept
+        {
+            const uint64_t h = this->head_.load(std::memory_order_relaxed);
+            this->events_[h & this->mask_] = e;
+            this->head_.store(h + 1, std::memory_order_release);
+        }
+
+        /// \brief Copies the retained events, oldest first.
+        [[nodiscard]] std::vector<Event> snapshot() const;
+
+        void clear() noexcept { this->tail_.store(this->head_.load(std::memory_order_acquire), std::memory_order_relaxed); }
+
+        [[nodiscard]] int tid() const noexcept { return this->tid_; }
+
+    private:
+        int tid_;
+        size_t mask_;
+        std::unique_ptr<Event[]> events_;
+        std::atomic<uint64_t> head_{0};
+        std::atomic<uint64_t> tail_{0};
+    };
+
+    uint64_t now_ns() noexcept;
+
+    /// \brief Trace buffer of the calling thread, created and registered on first use.
+    TraceBuffer& local_buffer();
+
+    inline void instant(EventType type, const void* subject, int64_t arg) noexcept
+    {
+        local_buffer().push(Event{now_ns(), 0, subject, arg, type});
+    }
+
+    /// \brief Records a complete event spanning its lifetime.
+    class Scope
+    {
+    public:
+        Scope(EventType type, const void* subject, int64_t arg) noexcept :
+            start_(now_ns()), subject_(subject), arg_(arg), type_(type)
+        {
+        }
+
+        ~Scope() { local_buffer().push(Event{this->start_, now_ns() - this->start_, this->subject_, this->arg_, this->type_}); }
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        uint64_t start_;
+        const void* subject_;
+        int64_t arg_;
+        EventType type_;
+    };
+
+    /**
+     * @brief Writes the events of all threads as Chrome trace JSON, loadable in Perfetto or chrome://tracing.
+     *
+     * Intended to be called after `Uvent::stop()`; called while workers run, the most recent events of a
+     * thread may be missing or, if its ring wrapped during the dump, torn.
+     *
+     * @return false if the file could not be written.
+     */
+    bool dump_chrome_trace(const std::string& path);
+
+    /// \brief Drops all recorded events.
+    void clear();
+} // namespace usub::uvent::utils::trace
+
+#ifdef UVENT_ENABLE_TRACING
+#define UVENT_TRACE_CONCAT_IMPL(a, b) a##b
+#define UVENT_TRACE_CONCAT(a, b) UVENT_TRACE_CONCAT_IMPL(a, b)
+#define UVENT_TRACE_SCOPE(type, subject, arg)                                                                          \
+    ::usub::uvent::utils::trace::Scope UVENT_TRACE_CONCAT(uvent_trace_scope_, __LINE__)                                \
+    {                                                                                                                  \
+        ::usub::uvent::utils::trace::EventType::type, subject, static_cast<int64_t>(arg)                               \
+    }
+#define UVENT_TRACE_INSTANT(type, subject, arg)                                                                        \
+    ::usub::uvent::utils::trace::instant(::usub::uvent::utils::trace::EventType::type, subject,                        \
+                                         static_cast<int64_t>(arg))
+#else
+#define UVENT_TRACE_SCOPE(type, subject, arg) ((void)0)
+#define UVENT_TRACE_INSTANT(type, subject, arg) ((void)0)
+#endif
+
+#endif // UVENT_TRACE_H
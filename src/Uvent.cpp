@@ -4,13 +4,136 @@
 
 #include "uvent/Uvent.h"
 
+#ifndef OS_WINDOWS
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#ifdef OS_LINUX
+#include <linux/filter.h>
+#endif
+
 namespace usub {
-    Uvent::Uvent(int threadCount) : pool(threadCount), thread_count_(threadCount)
+    namespace {
+        uvent::task::Awaitable<void> autoscaler_loop(Uvent* uvent, const std::atomic<uint64_t>* generation,
+                                                     uint64_t id, AutoscalerConfig cfg) {
+            std::vector<uint64_t> last_park;
+            while (generation->load(std::memory_order_relaxed) == id) {
+                co_await uvent::system::this_coroutine::sleep_for(std::chrono::milliseconds(cfg.interval_ms));
+                if (generation->load(std::memory_order_relaxed) != id)
+                    break;
+
+                const auto stats = uvent->thread_stats();
+                last_park.resize(stats.size(), 0);
+                int active = 0;
+                uint64_t queued = 0, parked_ns = 0;
+                for (size_t i = 0; i < stats.size(); ++i) {
+                    const auto &s = stats[i];
+                    if (!uvent::system::global::detail::tls_registry->getStorage(static_cast<int>(i))->retired()) {
+                        ++active;
+                        queued += s.run_queue_depth + s.local_queue_depth + s.inbox_depth;
+                        parked_ns += s.idle.park_ns - std::min(s.idle.park_ns, last_park[i]);
+                    }
+                    last_park[i] = s.idle.park_ns;
+                }
+                if (active == 0)
+                    continue;
+                queued += stats.front().global_queue_depth;
+
+                const double depth = static_cast<double>(queued) / active;
+                const double idle = static_cast<double>(parked_ns) / (1e6 * cfg.interval_ms * active);
+                if (depth > cfg.grow_queue_depth && active < cfg.max_threads)
+                    uvent->resize(active + 1);
+                else if (idle > cfg.shrink_idle_ratio && active > cfg.min_threads)
+                    uvent->resize(active - 1);
+            }
+        }
+
+#ifdef OS_LINUX
+        /// \brief Steers each connection to the listener whose worker is pinned to the receiving CPU.
+        void attach_cpu_program(int fd, const std::vector<std::vector<int>> &listener_cpus) {
+            std::vector<sock_filter> code;
+            code.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+            for (size_t k = 0; k < listener_cpus.size(); ++k) {
+                for (const int cpu: listener_cpus[k]) {
+                    if (code.size() + 4 > BPF_MAXINSNS)
+                        break;
+                    code.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<uint32_t>(cpu), 0, 1));
+                    code.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(k)));
+                }
+            }
+            code.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, static_cast<uint32_t>(listener_cpus.size())));
+            code.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+
+            sock_fprog prog{static_cast<unsigned short>(code.size()), code.data()};
+            if (::setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0)
+                throw std::system_error(errno, std::generic_category(), "setsockopt(SO_ATTACH_REUSEPORT_CBPF)");
+        }
+#endif
+    }
+
+    Uvent::Uvent(int threadCount) : Uvent(threadCount, uvent::system::ThreadPlacement::from_build())
+    {
+    }
+
+    Uvent::Uvent(int threadCount, const uvent::system::ThreadPlacement& placement) :
+        pool(threadCount, placement), thread_count_(threadCount)
     {
         uvent::system::global::detail::thread_count = threadCount;
     }
 
+    Uvent::Listeners::~Listeners() {
+#ifndef OS_WINDOWS
+        for (const auto &[fd, worker]: this->open)
+            ::close(fd);
+#endif
+    }
+
+#ifndef OS_WINDOWS
+    uvent::task::Awaitable<void> Uvent::accept_loop(int fd, std::shared_ptr<ConnectionHandler> handler,
+                                                    Listeners *listeners) {
+        auto *header = new uvent::net::SocketHeader{
+            .fd = fd,
+            .socket_info = static_cast<uint8_t>(static_cast<uint8_t>(uvent::net::Proto::TCP) |
+                                                static_cast<uint8_t>(uvent::net::Role::PASSIVE)),
+#ifndef UVENT_ENABLE_REUSEADDR
+            .state = std::atomic<uint64_t>((1ull & utils::sync::refc::COUNT_MASK))
+#else
+            .state = (1ull & utils::sync::refc::COUNT_MASK)
+#endif
+        };
+        // registered from the worker itself, so the listener belongs to this worker's poller
+        uvent::system::this_thread::detail::pl.addEvent(header, uvent::core::OperationType::READ);
+        uvent::net::TCPServerSocket listener{header};
+        for (;;) {
+            // async_accept() retries transient errors itself: a failure means the listener was shut down
+            auto client = co_await listener.async_accept();
+            if (!client)
+                break;
+            auto task = (*handler)(std::move(*client));
+            // the bound run queue, not the stealable one: the connection stays on this worker
+            if (auto promise = task.get_promise())
+                uvent::system::this_thread::detail::enqueue_frame(promise->get_coroutine_handle());
+        }
+        // `listener` closes the fd when the frame ends: nobody may shut it down after that
+        std::lock_guard lock(listeners->mtx);
+        std::erase_if(listeners->open, [fd](const auto &l) { return l.first == fd; });
+        if (listeners->open.empty())
+            listeners->cbpf = false;
+    }
+#endif
+
+    void Uvent::shutdown_listeners(bool all) {
+#ifndef OS_WINDOWS
+        auto *registry = uvent::system::global::detail::tls_registry.get();
+        std::lock_guard lock(this->listeners_.mtx);
+        for (const auto &[fd, worker]: this->listeners_.open)
+            if (all || registry->getStorage(worker)->retired())
+                ::shutdown(fd, SHUT_RDWR);
+#endif
+    }
+
     void Uvent::stop() {
+        this->shutdown_listeners(true);
         this->pool.stop();
     }
 
@@ -18,9 +141,135 @@ namespace usub {
         this->pool.addThread(uvent::system::CURRENT);
     }
 
+    size_t Uvent::poll_once(std::chrono::milliseconds timeout) {
+        return this->pool.pollOnce(static_cast<int>(std::clamp<int64_t>(timeout.count(), 0, INT32_MAX)));
+    }
+
+    size_t Uvent::run_for(std::chrono::nanoseconds duration) {
+        using namespace std::chrono;
+        const auto deadline = steady_clock::now() + duration;
+        size_t resumed = 0;
+        for (;;) {
+            const auto left = deadline - steady_clock::now();
+            // once stopped, pollOnce() only releases the calling thread
+            if (this->pool.stopped())
+                return resumed + this->pool.pollOnce(0);
+            if (left <= nanoseconds::zero())
+                break;
+            // round up, so the last iteration does not turn into a busy poll
+            const auto timeout_ms = std::min<int64_t>(ceil<milliseconds>(left).count(), INT32_MAX);
+            resumed += this->pool.pollOnce(static_cast<int>(timeout_ms));
+        }
+        return resumed;
+    }
+
     void Uvent::for_each_thread(std::function<void(int, uvent::thread::ThreadLocalStorage*)> f) const
     {
-        for (int i = 0; i < this->thread_count_; i++)
+        const int total = uvent::system::global::detail::thread_count.load(std::memory_order_acquire);
+        for (int i = 0; i < total; i++)
             f(i, uvent::system::global::detail::tls_registry->getStorage(i));
     }
+
+    std::vector<uvent::thread::ThreadStats> Uvent::thread_stats() const
+    {
+        std::vector<uvent::thread::ThreadStats> stats;
+        this->for_each_thread([&](int, uvent::thread::ThreadLocalStorage* tls) { stats.push_back(tls->stats()); });
+        return stats;
+    }
+
+    void Uvent::resize(int threadCount) {
+        {
+            std::lock_guard lock(this->listeners_.mtx);
+            // retiring a worker closes its listener, and the kernel refills the hole with the group's last socket
+            if (this->listeners_.cbpf && threadCount < this->pool.activeThreads())
+                throw std::system_error(std::make_error_code(std::errc::operation_not_supported),
+                                        "resize() below the workers of CBPF_CPU listeners");
+        }
+        this->pool.resize(threadCount);
+        this->shutdown_listeners(false);
+    }
+
+    int Uvent::active_threads() const {
+        return this->pool.activeThreads();
+    }
+
+    void Uvent::enable_autoscaler(AutoscalerConfig config) {
+        config.min_threads = std::max(config.min_threads, 1);
+        config.max_threads = std::max(config.max_threads, config.min_threads);
+        config.interval_ms = std::max(config.interval_ms, 1);
+        {
+            std::lock_guard lock(this->listeners_.mtx);
+            if (this->listeners_.cbpf)
+                throw std::system_error(std::make_error_code(std::errc::operation_not_supported),
+                                        "enable_autoscaler() with CBPF_CPU listeners");
+            this->autoscaler_enabled_.store(true, std::memory_order_relaxed);
+        }
+        const uint64_t id = this->autoscaler_generation_.fetch_add(1, std::memory_order_relaxed) + 1;
+        uvent::system::co_spawn_static(autoscaler_loop(this, &this->autoscaler_generation_, id, config), 0);
+    }
+
+    void Uvent::disable_autoscaler() {
+        this->autoscaler_enabled_.store(false, std::memory_order_relaxed);
+        this->autoscaler_generation_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Uvent::listen_per_thread(const ListenerConfig &config, ConnectionHandler handler) {
+#ifdef OS_WINDOWS
+        throw std::system_error(std::make_error_code(std::errc::operation_not_supported), "listen_per_thread()");
+#else
+        auto *registry = uvent::system::global::detail::tls_registry.get();
+        const int total = uvent::system::global::detail::thread_count.load(std::memory_order_acquire);
+        const auto slots = this->pool.workerSlots();
+
+        std::vector<int> workers;
+        for (int i = 0; i < total; ++i)
+            if (!registry->getStorage(i)->retired())
+                workers.push_back(i);
+
+        // opened in worker order: the position of a listener in the reuseport group is its index here
+        std::vector<int> fds;
+        std::vector<std::vector<int>> listener_cpus;
+        try {
+            for (const int w: workers) {
+                fds.push_back(uvent::utils::socket::createSocket(config.port, config.ip, config.backlog, config.ipv,
+                                                                 uvent::utils::net::TCP));
+                uvent::utils::socket::makeSocketNonBlocking(fds.back());
+                listener_cpus.push_back(w < static_cast<int>(slots.size()) ? slots[w].cpus : std::vector<int>{});
+            }
+#ifdef OS_LINUX
+            if (config.steering == ReuseportSteering::INCOMING_CPU) {
+                for (size_t k = 0; k < fds.size(); ++k) {
+                    if (listener_cpus[k].empty())
+                        continue;
+                    int cpu = listener_cpus[k].front();
+                    if (::setsockopt(fds[k], SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu)) < 0)
+                        throw std::system_error(errno, std::generic_category(), "setsockopt(SO_INCOMING_CPU)");
+                }
+            } else if (config.steering == ReuseportSteering::CBPF_CPU && !fds.empty())
+                attach_cpu_program(fds.front(), listener_cpus);
+#endif
+        } catch (...) {
+            for (const int fd: fds)
+                ::close(fd);
+            throw;
+        }
+
+        {
+            std::lock_guard lock(this->listeners_.mtx);
+            if (config.steering == ReuseportSteering::CBPF_CPU &&
+                this->autoscaler_enabled_.load(std::memory_order_relaxed)) {
+                for (const int fd: fds)
+                    ::close(fd);
+                throw std::system_error(std::make_error_code(std::errc::operation_not_supported),
+                                        "listen_per_thread(CBPF_CPU) with the autoscaler enabled");
+            }
+            for (size_t k = 0; k < fds.size(); ++k)
+                this->listeners_.open.emplace_back(fds[k], workers[k]);
+            this->listeners_.cbpf = this->listeners_.cbpf || config.steering == ReuseportSteering::CBPF_CPU;
+        }
+        auto shared = std::make_shared<ConnectionHandler>(std::move(handler));
+        for (size_t k = 0; k < fds.size(); ++k)
+            uvent::system::co_spawn_static(accept_loop(fds[k], shared, &this->listeners_), workers[k]);
+#endif
+    }
 }
@@ -0,0 +1,149 @@
+//
+// Created by root on 10/16/26.
+//
+
+#include "uvent/fs/File.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+#include "uvent/pool/BlockingPool.h"
+
+namespace usub::uvent::fs
+{
+    namespace detail
+    {
+#ifdef UVENT_ENABLE_IO_URING
+        OpenAwaiter::OpenAwaiter(std::string path, int flags, mode_t mode) noexcept : path_str_(std::move(path))
+        {
+            this->op_.kind = core::detail::IoOpKind::OpenAt;
+            this->op_.path = this->path_str_.c_str();
+            this->op_.open_flags = flags | O_CLOEXEC;
+            this->op_.mode = mode;
+        }
+
+        std::expected<File, int> OpenAwaiter::await_resume() noexcept
+        {
+            const ssize_t res = FileOpAwaiter::await_resume();
+            if (res < 0)
+                return std::unexpected(static_cast<int>(-res));
+            return File{static_cast<int>(res)};
+        }
+#else
+        namespace
+        {
+            /// \brief Operations issued by this worker since the last flush, in issue order.
+            thread_local FileOpAwaiter* pending_head = nullptr;
+            thread_local FileOpAwaiter* pending_tail = nullptr;
+            thread_local size_t pending_count = 0;
+
+            /// \brief Longest chain a single pool job runs, so one slow operation delays few others.
+            constexpr size_t MAX_CHAIN = 16;
+        } // namespace
+
+        void FileOpAwaiter::suspend(uvent::detail::WakeHandle h) noexcept
+        {
+            this->h_ = h;
+            this->t_id_ = system::this_thread::detail::t_id;
+            this->priority_ = system::this_thread::detail::cur_priority;
+            this->next_ = nullptr;
+            if (!system::this_thread::detail::tls)
+            {
+                // not on a worker: there is no loop iteration to batch with
+                BlockingPool::instance().submit({&FileOpAwaiter::run_chain, this});
+                return;
+            }
+            if (pending_tail)
+                pending_tail->next_ = this;
+            else
+                pending_head = this;
+            pending_tail = this;
+            ++pending_count;
+        }
+
+        void FileOpAwaiter::execute() noexcept
+        {
+            ssize_t r = 0;
+            switch (this->kind_)
+            {
+                case FileOpKind::READ_AT:
+                    r = ::pread(this->fd_, this->buf_, this->len_, static_cast<off_t>(this->offset_));
+                    break;
+                case FileOpKind::WRITE_AT:
+                    r = ::pwrite(this->fd_, this->buf_, this->len_, static_cast<off_t>(this->offset_));
+                    break;
+                case FileOpKind::FSYNC:
+                    r = ::fsync(this->fd_);
+                    break;
+                case FileOpKind::FDATASYNC:
+#ifdef OS_APPLE
+                    r = ::fsync(this->fd_);
+#else
+                    r = ::fdatasync(this->fd_);
+#endif
+                    break;
+                case FileOpKind::OPEN:
+                    r = ::open(this->path_, this->open_flags_, this->mode_);
+                    break;
+            }
+            this->res_ = r < 0 ? -errno : r;
+        }
+
+        void FileOpAwaiter::run_chain(void* head) noexcept
+        {
+            for (auto* op = static_cast<FileOpAwaiter*>(head); op;)
+            {
+                // the awaiter lives in the suspended frame: it may be gone as soon as the coroutine is queued
+                auto* next = op->next_;
+                op->execute();
+                uvent::detail::resume_on(op->h_, op->t_id_, op->priority_);
+                op = next;
+            }
+        }
+
+        void flush_pending() noexcept
+        {
+            if (!pending_head)
+                return;
+            auto* op = std::exchange(pending_head, nullptr);
+            pending_tail = nullptr;
+            const size_t count = std::exchange(pending_count, 0);
+
+            // spread the batch over the pool threads instead of running it serially on one of them
+            const size_t threads = static_cast<size_t>(std::max(1, settings::blocking_pool_threads));
+            const size_t chunk = std::min((count + threads - 1) / threads, MAX_CHAIN);
+            while (op)
+            {
+                auto* head = op;
+                for (size_t i = 1; i < chunk && op->next_; ++i)
+                    op = op->next_;
+                auto* rest = std::exchange(op->next_, nullptr);
+                BlockingPool::instance().submit({&FileOpAwaiter::run_chain, head});
+                op = rest;
+            }
+        }
+
+        OpenAwaiter::OpenAwaiter(std::string path, int flags, mode_t mode) noexcept : path_str_(std::move(path))
+        {
+            this->kind_ = FileOpKind::OPEN;
+            this->path_ = this->path_str_.c_str();
+            this->open_flags_ = flags | O_CLOEXEC;
+            this->mode_ = mode;
+        }
+
+        std::expected<File, int> OpenAwaiter::await_resume() noexcept
+        {
+            if (this->res_ < 0)
+                return std::unexpected(static_cast<int>(-this->res_));
+            return File{static_cast<int>(this->res_)};
+        }
+#endif
+    } // namespace detail
+
+    void File::close() noexcept
+    {
+        if (this->fd_ >= 0)
+            ::close(std::exchange(this->fd_, -1));
+    }
+} // namespace usub::uvent::fs
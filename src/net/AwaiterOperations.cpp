@@ -13,6 +13,7 @@ namespace usub::uvent::net::detail {
             std::coroutine_handle<uvent::detail::AwaitableFrameBase>::from_address(h.address());
 
         this->header_->first = c;
+        this->header_->first_priority = system::this_thread::detail::cur_priority;
         this->header_->clear_busy();
     }
 
@@ -27,6 +28,7 @@ namespace usub::uvent::net::detail {
             std::coroutine_handle<uvent::detail::AwaitableFrameBase>::from_address(h.address());
 
         this->header_->second = c;
+        this->header_->second_priority = system::this_thread::detail::cur_priority;
         this->header_->clear_busy();
     }
 
@@ -41,6 +43,7 @@ namespace usub::uvent::net::detail {
             std::coroutine_handle<uvent::detail::AwaitableFrameBase>::from_address(h.address());
 
         this->header_->first = c;
+        this->header_->first_priority = system::this_thread::detail::cur_priority;
         this->header_->clear_busy();
     }
 
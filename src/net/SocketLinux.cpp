@@ -30,6 +30,7 @@ namespace usub::uvent::net::detail
 #endif
         auto r = std::exchange(header->first, nullptr);
         auto w = std::exchange(header->second, nullptr);
+        header->first_retry = header->second_retry = nullptr;
 #ifndef UVENT_ENABLE_REUSEADDR
         header->clear_busy();
 #endif
@@ -39,11 +40,11 @@ namespace usub::uvent::net::detail
 #endif
         header->socket_info |= static_cast<uint8_t>(AdditionalState::TIMEOUT);
 #ifndef UVENT_ENABLE_REUSEADDR
-            if (!header->is_done_client_coroutine_with_timeout() && r) system::this_thread::detail::q->enqueue(r);
-            if (!header->is_done_client_coroutine_with_timeout() && w) system::this_thread::detail::q->enqueue(w);
+            if (!header->is_done_client_coroutine_with_timeout() && r) system::this_thread::detail::enqueue_ready(r, header->first_priority);
+            if (!header->is_done_client_coroutine_with_timeout() && w) system::this_thread::detail::enqueue_ready(w, header->second_priority);
 #else
-        if (r) system::this_thread::detail::q->enqueue(r);
-        if (w) system::this_thread::detail::q->enqueue(w);
+        if (r) system::this_thread::detail::enqueue_ready(r, header->first_priority);
+        if (w) system::this_thread::detail::enqueue_ready(w, header->second_priority);
 #endif
 
 #ifndef UVENT_ENABLE_REUSEADDR
@@ -7,14 +7,52 @@
 #include "uvent/net/Socket.h"
 #include "uvent/system/Settings.h"
 #include "uvent/system/SystemContext.h"
+#include "uvent/utils/trace/Trace.h"
 
 namespace usub::uvent::core
 {
+    namespace
+    {
+        // a frameless waiter is woken once its retried operation got past EAGAIN; otherwise it stays armed
+        bool wake_waiter(net::SocketHeader* sock, net::ReadinessRetry*& retry, bool hup)
+        {
+            net::ReadinessRetry* r = std::exchange(retry, nullptr);
+            if (hup || !r || r->attempt(r->op))
+                return true;
+            retry = r;
+#ifndef UVENT_ENABLE_REUSEADDR
+            sock->clear_busy();
+#endif
+            return false;
+        }
+    } // namespace
+
     EPoller::EPoller(utils::TimerWheel& wheel) : wheel(wheel)
     {
         this->poll_fd = epoll_create1(0);
         sigemptyset(&this->sigmask);
         this->events.resize(1000);
+
+        // level-triggered and tagged with a null pointer, so poll() can tell it apart from sockets
+        this->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        struct epoll_event event{};
+        event.data.ptr = nullptr;
+        event.events = EPOLLIN;
+        epoll_ctl(this->poll_fd, EPOLL_CTL_ADD, this->wake_fd, &event);
+    }
+
+    EPoller::~EPoller()
+    {
+        if (this->wake_fd >= 0)
+            ::close(this->wake_fd);
+        if (this->poll_fd >= 0)
+            ::close(this->poll_fd);
+    }
+
+    void EPoller::wakeup()
+    {
+        const uint64_t one = 1;
+        [[maybe_unused]] auto r = ::write(this->wake_fd, &one, sizeof(one));
     }
 
     void EPoller::addEvent(net::SocketHeader* header, OperationType initialState)
@@ -30,6 +68,7 @@ namespace usub::uvent::core
 #endif
 
         epoll_ctl(this->poll_fd, EPOLL_CTL_ADD, header->fd, &event);
+        thread::ThreadLocalStorage::socket_registered(header);
     }
 
 
@@ -82,6 +121,7 @@ namespace usub::uvent::core
 #endif
         using namespace usub::utils::sync::refc;
 
+        thread::ThreadLocalStorage::socket_unregistered(header);
         epoll_ctl(this->poll_fd, EPOLL_CTL_DEL, header->fd, nullptr);
         ::close(header->fd);
         header->fd = -1;
@@ -89,6 +129,7 @@ namespace usub::uvent::core
 
     bool EPoller::poll(int timeout)
     {
+        UVENT_TRACE_SCOPE(POLL, this, timeout);
         int n = epoll_pwait(this->poll_fd, this->events.data(), static_cast<int>(this->events.size()), timeout,
                             &this->sigmask);
 #ifndef UVENT_ENABLE_REUSEADDR
@@ -102,6 +143,12 @@ namespace usub::uvent::core
         {
             auto& event = this->events[i];
             auto* sock = static_cast<net::SocketHeader*>(event.data.ptr);
+            if (!sock)
+            {
+                uint64_t value;
+                [[maybe_unused]] auto r = ::read(this->wake_fd, &value, sizeof(value));
+                continue;
+            }
 #ifndef UVENT_ENABLE_REUSEADDR
             if (sock->is_busy_now() || sock->is_disconnected_now())
                 continue;
@@ -112,13 +159,14 @@ namespace usub::uvent::core
 #ifndef UVENT_ENABLE_REUSEADDR
             sock->try_mark_busy();
 #endif
-            if (event.events & EPOLLIN && sock->first)
+            if (event.events & EPOLLIN && sock->first && wake_waiter(sock, sock->first_retry, hup))
             {
 #if UVENT_DEBUG
                 spdlog::info("Socket #{} triggered as IN", sock->fd);
 #endif
                 auto c = std::exchange(sock->first, nullptr);
-                system::this_thread::detail::q->enqueue(c);
+                system::this_thread::detail::enqueue_ready(c, sock->first_priority);
+                UVENT_TRACE_INSTANT(IO_READY, c.address(), sock->fd);
             }
             if (event.events & EPOLLOUT && sock->second)
             {
@@ -127,8 +175,12 @@ namespace usub::uvent::core
 #endif
                 if (!(sock->socket_info & static_cast<uint8_t>(net::AdditionalState::CONNECTION_PENDING)))
                 {
-                    auto c = std::exchange(sock->second, nullptr);
-                    system::this_thread::detail::q->enqueue(c);
+                    if (wake_waiter(sock, sock->second_retry, hup))
+                    {
+                        auto c = std::exchange(sock->second, nullptr);
+                        system::this_thread::detail::enqueue_ready(c, sock->second_priority);
+                        UVENT_TRACE_INSTANT(IO_READY, c.address(), sock->fd);
+                    }
                 }
                 else
                 {
@@ -141,7 +193,8 @@ namespace usub::uvent::core
                     else
                     {
                         auto c = std::exchange(sock->second, nullptr);
-                        system::this_thread::detail::q->enqueue(c);
+                        system::this_thread::detail::enqueue_ready(c, sock->second_priority);
+                        UVENT_TRACE_INSTANT(IO_READY, c.address(), sock->fd);
                     }
                 }
             }
@@ -1,12 +1,17 @@
 #include "uvent/poll/IOUringPoller.h"
 
+#include <algorithm>
+#include <climits>
 #include <system_error>
 #include <unistd.h>
+#include <sys/eventfd.h>
 #include <cstring>
+#include <fcntl.h>
 
 #include "uvent/system/SystemContext.h"
 #include "uvent/system/Settings.h"
 #include "uvent/tasks/AwaitableFrame.h"
+#include "uvent/utils/trace/Trace.h"
 
 namespace usub::uvent::core
 {
@@ -33,26 +38,58 @@ namespace usub::uvent::core
 
         sigemptyset(&this->sigmask);
 
+        // an eventfd instead of IORING_OP_MSG_RING: wakeups also come from threads that own no ring
+        this->wake_fd = ::eventfd(0, EFD_CLOEXEC);
+        this->wake_op.kind = IoOpKind::Wakeup;
+        this->arm_wakeup();
+
 #if UVENT_DEBUG
         spdlog::info("IOUringPoller ctor: entries={}", this->ring_entries);
 #endif
     }
 
+    void IOUringPoller::arm_wakeup()
+    {
+        auto* sqe = ::io_uring_get_sqe(&this->ring);
+        if (!sqe)
+        {
+            // the SQ is full of this iteration's operations: hand them to the kernel early
+            ::io_uring_submit(&this->ring);
+            sqe = ::io_uring_get_sqe(&this->ring);
+        }
+        // still no room: poll() tries again before it waits
+        this->wake_armed = sqe != nullptr;
+        if (!sqe) return;
+
+        ::io_uring_prep_read(sqe, this->wake_fd, &this->wake_value, sizeof(this->wake_value), 0);
+        ::io_uring_sqe_set_data(sqe, &this->wake_op);
+    }
+
+    void IOUringPoller::wakeup()
+    {
+        const uint64_t one = 1;
+        [[maybe_unused]] auto r = ::write(this->wake_fd, &one, sizeof(one));
+    }
+
     IOUringPoller::~IOUringPoller()
     {
         ::io_uring_queue_exit(&this->ring);
+        if (this->wake_fd >= 0)
+            ::close(this->wake_fd);
     }
 
-    void IOUringPoller::addEvent(net::SocketHeader*, OperationType)
+    void IOUringPoller::addEvent(net::SocketHeader* header, OperationType)
     {
+        thread::ThreadLocalStorage::socket_registered(header);
     }
 
     void IOUringPoller::updateEvent(net::SocketHeader*, OperationType)
     {
     }
 
-    void IOUringPoller::removeEvent(net::SocketHeader*)
+    void IOUringPoller::removeEvent(net::SocketHeader* header)
     {
+        thread::ThreadLocalStorage::socket_unregistered(header);
     }
 
     void IOUringPoller::submit_recv(RecvOp* op, int fd)
@@ -128,23 +165,74 @@ namespace usub::uvent::core
         ::io_uring_sqe_set_data(sqe, op);
     }
 
+    void IOUringPoller::submit_file(detail::FileOp* op)
+    {
+        if (!op) return;
+
+        auto* sqe = ::io_uring_get_sqe(&this->ring);
+        if (!sqe)
+        {
+            // the SQ is full of this iteration's operations: hand them to the kernel early
+            ::io_uring_submit(&this->ring);
+            sqe = ::io_uring_get_sqe(&this->ring);
+        }
+        if (!sqe)
+        {
+            op->res = -EBUSY;
+            op->err = EBUSY;
+            op->completed = true;
+            usub::uvent::system::this_thread::detail::enqueue_ready(op->coro, op->priority);
+            return;
+        }
+
+        // the SQE length is 32-bit: larger file requests complete short, like read(2)/write(2) past MAX_RW_COUNT
+        switch (op->kind)
+        {
+            case IoOpKind::ReadAt:
+                ::io_uring_prep_read(sqe, op->fd, op->buf, std::min<size_t>(op->len, UINT_MAX), op->offset);
+                break;
+            case IoOpKind::WriteAt:
+                ::io_uring_prep_write(sqe, op->fd, op->buf, std::min<size_t>(op->len, UINT_MAX), op->offset);
+                break;
+            case IoOpKind::Fsync:
+                ::io_uring_prep_fsync(sqe, op->fd, op->fsync_flags);
+                break;
+            case IoOpKind::OpenAt:
+                ::io_uring_prep_openat(sqe, AT_FDCWD, op->path, op->open_flags, op->mode);
+                break;
+            default:
+                ::io_uring_prep_nop(sqe);
+                break;
+        }
+        ::io_uring_sqe_set_data(sqe, op);
+    }
+
     void IOUringPoller::handle_cqe(struct io_uring_cqe* cqe)
     {
         auto* base = static_cast<IoOpBase*>(::io_uring_cqe_get_data(cqe));
         if (!base) return;
 
+        if (base == &this->wake_op)
+        {
+            this->wake_armed = false;
+            this->arm_wakeup();
+            return;
+        }
+
         base->res = cqe->res;
         base->err = (cqe->res < 0) ? -cqe->res : 0;
         base->completed = true;
 
         if (base->coro && !base->coro.done())
         {
-            usub::uvent::system::this_thread::detail::q->enqueue(base->coro);
+            usub::uvent::system::this_thread::detail::enqueue_ready(base->coro, base->priority);
+            UVENT_TRACE_INSTANT(IO_READY, base->coro.address(), base->header ? base->header->fd : -1);
         }
     }
 
     bool IOUringPoller::poll(int timeout_ms)
     {
+        UVENT_TRACE_SCOPE(POLL, this, timeout_ms);
         __kernel_timespec ts{};
         __kernel_timespec* tsp = nullptr;
 
@@ -155,6 +243,9 @@ namespace usub::uvent::core
             tsp = &ts;
         }
 
+        // without a pending read of the eventfd a wakeup() could not interrupt the wait
+        if (!this->wake_armed)
+            this->arm_wakeup();
         ::io_uring_submit(&this->ring);
 
 #ifndef UVENT_ENABLE_REUSEADDR
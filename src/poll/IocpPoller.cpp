@@ -2,6 +2,7 @@
 #include "uvent/system/SystemContext.h"
 #include "uvent/system/Settings.h"
 #include "uvent/net/SocketWindows.h"
+#include "uvent/utils/trace/Trace.h"
 
 namespace usub::uvent::core
 {
@@ -24,6 +25,12 @@ namespace usub::uvent::core
 #endif
     }
 
+    void IocpPoller::wakeup()
+    {
+        // a completion without key and OVERLAPPED is skipped by poll(), it only ends the wait
+        ::PostQueuedCompletionStatus(this->iocp_handle, 0, 0, nullptr);
+    }
+
     IocpPoller::~IocpPoller()
     {
 #if UVENT_DEBUG
@@ -63,6 +70,7 @@ namespace usub::uvent::core
         }
 #endif
         (void)h;
+        thread::ThreadLocalStorage::socket_registered(header);
     }
 
     void IocpPoller::updateEvent(net::SocketHeader* header, OperationType op)
@@ -87,6 +95,7 @@ namespace usub::uvent::core
         if (!header)
             return;
 
+        thread::ThreadLocalStorage::socket_unregistered(header);
         if (header->fd != INVALID_FD)
         {
 #if UVENT_DEBUG
@@ -100,6 +109,7 @@ namespace usub::uvent::core
 
     bool IocpPoller::poll(int timeout_ms)
     {
+        UVENT_TRACE_SCOPE(POLL, this, timeout_ms);
         DWORD timeout = (timeout_ms < 0) ? 0 : static_cast<DWORD>(timeout_ms);
         ULONG n = 0;
 
@@ -196,7 +206,8 @@ namespace usub::uvent::core
                     spdlog::trace("IocpPoller::poll: enqueue FIRST continuation fd={}",
                                   (std::uint64_t)header->fd);
 #endif
-                    system::this_thread::detail::q->enqueue(c);
+                    system::this_thread::detail::enqueue_ready(c, header->first_priority);
+                    UVENT_TRACE_INSTANT(IO_READY, c.address(), header->fd);
                 }
             }
             else if (ov->op == net::IocpOp::WRITE || ov->op == net::IocpOp::CONNECT)
@@ -235,7 +246,8 @@ namespace usub::uvent::core
                     spdlog::trace("IocpPoller::poll: enqueue SECOND continuation fd={}",
                                   (std::uint64_t)header->fd);
 #endif
-                    system::this_thread::detail::q->enqueue(c);
+                    system::this_thread::detail::enqueue_ready(c, header->second_priority);
+                    UVENT_TRACE_INSTANT(IO_READY, c.address(), header->fd);
                 }
             }
 
@@ -7,6 +7,7 @@
 #include "uvent/net/Socket.h"
 #include "uvent/system/Settings.h"
 #include "uvent/system/SystemContext.h"
+#include "uvent/utils/trace/Trace.h"
 
 namespace usub::uvent::core
 {
@@ -17,6 +18,25 @@ namespace usub::uvent::core
             throw std::system_error(errno, std::generic_category(), "kqueue()");
         sigemptyset(&this->sigmask);
         this->events.resize(1024);
+
+        // user event with null udata, skipped by poll() like any other event without a socket
+        struct kevent ev{};
+        EV_SET(&ev, WAKEUP_IDENT, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+        if (kevent(this->poll_fd, &ev, 1, nullptr, 0, nullptr) == -1)
+            throw std::system_error(errno, std::generic_category(), "kevent(EVFILT_USER)");
+    }
+
+    KQueuePoller::~KQueuePoller()
+    {
+        if (this->poll_fd >= 0)
+            ::close(this->poll_fd);
+    }
+
+    void KQueuePoller::wakeup()
+    {
+        struct kevent ev{};
+        EV_SET(&ev, WAKEUP_IDENT, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+        kevent(this->poll_fd, &ev, 1, nullptr, 0, nullptr);
     }
 
     void KQueuePoller::addEvent(net::SocketHeader* header, OperationType initialState)
@@ -38,6 +58,7 @@ namespace usub::uvent::core
             enable_write(header, true, edge_like);
             break;
         }
+        thread::ThreadLocalStorage::socket_registered(header);
     }
 
     void KQueuePoller::updateEvent(net::SocketHeader* header, OperationType initialState)
@@ -63,6 +84,7 @@ namespace usub::uvent::core
 
     void KQueuePoller::removeEvent(net::SocketHeader* header, OperationType)
     {
+        thread::ThreadLocalStorage::socket_unregistered(header);
         struct kevent ev{};
         EV_SET(&ev, header->fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
         kevent(this->poll_fd, &ev, 1, nullptr, 0, nullptr);
@@ -75,6 +97,7 @@ namespace usub::uvent::core
 
     bool KQueuePoller::poll(int timeout_ms)
     {
+        UVENT_TRACE_SCOPE(POLL, this, timeout_ms);
         struct timespec ts{};
         if (timeout_ms < 0)
         {
@@ -134,7 +157,8 @@ namespace usub::uvent::core
                 spdlog::info("Socket #{} triggered as IN", sock->fd);
 #endif
                 auto c = std::exchange(sock->first, nullptr);
-                system::this_thread::detail::q->enqueue(c);
+                system::this_thread::detail::enqueue_ready(c, sock->first_priority);
+                UVENT_TRACE_INSTANT(IO_READY, c.address(), sock->fd);
             }
 
             if (ev.filter == EVFILT_WRITE && sock->second)
@@ -145,7 +169,8 @@ namespace usub::uvent::core
                 if (!(sock->socket_info & static_cast<uint8_t>(net::AdditionalState::CONNECTION_PENDING)))
                 {
                     auto c = std::exchange(sock->second, nullptr);
-                    system::this_thread::detail::q->enqueue(c);
+                    system::this_thread::detail::enqueue_ready(c, sock->second_priority);
+                    UVENT_TRACE_INSTANT(IO_READY, c.address(), sock->fd);
                 }
                 else
                 {
@@ -163,7 +188,8 @@ namespace usub::uvent::core
                     else
                     {
                         auto c = std::exchange(sock->second, nullptr);
-                        system::this_thread::detail::q->enqueue(c);
+                        system::this_thread::detail::enqueue_ready(c, sock->second_priority);
+                        UVENT_TRACE_INSTANT(IO_READY, c.address(), sock->fd);
                     }
                 }
             }
@@ -0,0 +1,65 @@
+//
+// Created by root on 10/16/26.
+//
+
+#include "uvent/pool/BlockingPool.h"
+
+#include <algorithm>
+
+#include "uvent/system/Settings.h"
+
+namespace usub::uvent
+{
+    BlockingPool& BlockingPool::instance()
+    {
+        static BlockingPool pool;
+        return pool;
+    }
+
+    void BlockingPool::submit(Job job)
+    {
+        {
+            std::lock_guard lock(this->mtx_);
+            if (this->threads_.empty())
+            {
+                const int n = std::max(1, settings::blocking_pool_threads);
+                this->threads_.reserve(n);
+                for (int i = 0; i < n; ++i)
+                    this->threads_.emplace_back([this](std::stop_token token) { this->worker(token); });
+            }
+            this->jobs_.push_back(job);
+            ++this->submitted_;
+            this->max_depth_ = std::max(this->max_depth_, this->jobs_.size());
+        }
+        this->cv_.notify_one();
+    }
+
+    BlockingPoolStats BlockingPool::stats() const
+    {
+        std::lock_guard lock(this->mtx_);
+        return {static_cast<int>(this->threads_.size()),
+                this->jobs_.size(),
+                this->max_depth_,
+                this->running_,
+                this->submitted_,
+                this->completed_};
+    }
+
+    void BlockingPool::worker(std::stop_token token)
+    {
+        std::unique_lock lock(this->mtx_);
+        for (;;)
+        {
+            if (!this->cv_.wait(lock, token, [this] { return !this->jobs_.empty(); }))
+                return;
+            const Job job = this->jobs_.front();
+            this->jobs_.pop_front();
+            ++this->running_;
+            lock.unlock();
+            job.fn(job.arg);
+            lock.lock();
+            --this->running_;
+            ++this->completed_;
+        }
+    }
+} // namespace usub::uvent
@@ -3,14 +3,219 @@
 //
 
 #include <uvent/pool/TLS.h>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include "uvent/system/SystemContext.h"
+
+#ifdef OS_LINUX
+#ifndef UVENT_ENABLE_IO_URING
+#include "uvent/poll/EPoller.h"
+#else
+#include "uvent/poll/IOUringPoller.h"
+#endif
+#elif OS_BSD || OS_APPLE
+#include "uvent/poll/KPoller.h"
+#else
+#include "uvent/poll/IocpPoller.h"
+#endif
 
 namespace usub::uvent::thread
 {
+    ThreadLocalStorage::ThreadLocalStorage(int numa_node) :
+        local_q_(static_cast<size_t>(settings::local_queue_capacity)), numa_node_(numa_node)
+    {
+    }
+
+    uint64_t ThreadLocalStorage::inbox_depth() const noexcept
+    {
+        // popped first: a task is counted as pushed before it becomes visible to the consumer
+        const uint64_t popped = this->inbox_popped_.load(std::memory_order_acquire);
+        const uint64_t pushed = this->inbox_pushed_.load(std::memory_order_acquire);
+        return pushed > popped ? pushed - popped : 0;
+    }
+
+    void ThreadLocalStorage::push_task_inbox(std::coroutine_handle<uvent::detail::AwaitableFrameBase> task)
+    {
+        if (!task)
+            return;
+        this->inbox_pushed_.fetch_add(1, std::memory_order_relaxed);
+        this->inbox_q_.push(&task.promise());
+
+        this->is_added_new_.store(true, std::memory_order_release);
+        this->wake_if_parked();
+    }
+
     void ThreadLocalStorage::push_task_inbox(std::coroutine_handle<> task)
     {
-        while (!this->inbox_q_.try_enqueue(task))
-            cpu_relax();
+        if (task)
+            this->push_task_inbox(uvent::detail::wrap_foreign(task));
+    }
+
+    void ThreadLocalStorage::push_tasks_inbox(const std::coroutine_handle<uvent::detail::AwaitableFrameBase>* tasks,
+                                              size_t n)
+    {
+        using Inbox = decltype(this->inbox_q_);
+        uvent::detail::AwaitableFrameBase* first = nullptr;
+        uvent::detail::AwaitableFrameBase* last = nullptr;
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!tasks[i])
+                continue;
+            auto* f = &tasks[i].promise();
+            if (last)
+                Inbox::link(last, f);
+            else
+                first = f;
+            last = f;
+            ++count;
+        }
+        this->push_chain_inbox(first, last, count);
+    }
+
+    void ThreadLocalStorage::push_tasks_inbox(const std::coroutine_handle<>* tasks, size_t n)
+    {
+        using Inbox = decltype(this->inbox_q_);
+        uvent::detail::AwaitableFrameBase* first = nullptr;
+        uvent::detail::AwaitableFrameBase* last = nullptr;
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!tasks[i])
+                continue;
+            auto* f = &uvent::detail::wrap_foreign(tasks[i]).promise();
+            if (last)
+                Inbox::link(last, f);
+            else
+                first = f;
+            last = f;
+            ++count;
+        }
+        this->push_chain_inbox(first, last, count);
+    }
+
+    void ThreadLocalStorage::push_chain_inbox(uvent::detail::AwaitableFrameBase* first,
+                                              uvent::detail::AwaitableFrameBase* last, size_t count)
+    {
+        if (count == 0)
+            return;
+
+        this->inbox_pushed_.fetch_add(count, std::memory_order_relaxed);
+        this->inbox_q_.push_chain(first, last);
 
         this->is_added_new_.store(true, std::memory_order_release);
+        this->wake_if_parked();
+    }
+
+    bool ThreadLocalStorage::try_push_task_inbox(std::coroutine_handle<uvent::detail::AwaitableFrameBase> task)
+    {
+        if (this->inbox_depth() >= INBOX_SOFT_CAPACITY)
+            return false;
+
+        this->push_task_inbox(task);
+        return true;
+    }
+
+    bool ThreadLocalStorage::wake_if_parked()
+    {
+        // pairs with the fence in Thread::parkOrPoll: either the owner sees the new work
+        // before blocking, or this thread sees parked_ == true
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!this->parked_.load(std::memory_order_relaxed) || !this->parked_.exchange(false, std::memory_order_acq_rel))
+            return false;
+
+        this->poller_->wakeup();
+        return true;
+    }
+
+    bool ThreadLocalStorage::push_task_local(std::coroutine_handle<> task)
+    {
+        // a retired thread hands new work to the active ones through the global queue
+        return !this->retired_.load(std::memory_order_relaxed) && this->local_q_.try_push(task);
+    }
+
+    size_t ThreadLocalStorage::push_tasks_local(const std::coroutine_handle<>* tasks, size_t n)
+    {
+        if (this->retired_.load(std::memory_order_relaxed))
+            return 0;
+        return this->local_q_.try_push_bulk(tasks, n);
+    }
+
+    size_t ThreadLocalStorage::steal_tasks(std::coroutine_handle<>* out, size_t max_items)
+    {
+        return this->local_q_.steal_half(out, max_items);
+    }
+
+    size_t ThreadLocalStorage::local_tasks_size() const noexcept { return this->local_q_.size_relaxed(); }
+
+    IdleStats ThreadLocalStorage::idle_stats() const noexcept
+    {
+        return IdleStats{
+            .spin_ns = this->idle_stats_.spin_ns.load(std::memory_order_relaxed),
+            .yield_ns = this->idle_stats_.yield_ns.load(std::memory_order_relaxed),
+            .park_ns = this->idle_stats_.park_ns.load(std::memory_order_relaxed),
+            .spin_hits = this->idle_stats_.spin_hits.load(std::memory_order_relaxed),
+            .yield_hits = this->idle_stats_.yield_hits.load(std::memory_order_relaxed),
+            .parks = this->idle_stats_.parks.load(std::memory_order_relaxed),
+        };
+    }
+
+    uint64_t ThreadLocalStorage::load() const noexcept
+    {
+        const int64_t sockets = this->live_sockets_.load(std::memory_order_relaxed);
+        return this->stats_.run_queue_depth.load(std::memory_order_relaxed) + this->local_q_.size_relaxed() +
+            this->inbox_depth() + static_cast<uint64_t>(std::max<int64_t>(0, sockets));
+    }
+
+    void ThreadLocalStorage::socket_registered(net::SocketHeader* header) noexcept
+    {
+        auto* tls = system::this_thread::detail::tls;
+        if (!tls || (header->is_tcp() && header->is_passive()))
+            return;
+        int32_t expected = -1;
+        if (!header->counted_tid.compare_exchange_strong(expected, system::this_thread::detail::t_id,
+                                                         std::memory_order_relaxed))
+            return;
+        tls->live_sockets_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void ThreadLocalStorage::socket_unregistered(net::SocketHeader* header) noexcept
+    {
+        const int tid = header->counted_tid.exchange(-1, std::memory_order_relaxed);
+        if (tid < 0 || !system::global::detail::tls_registry)
+            return;
+        system::global::detail::tls_registry->getStorage(tid)->live_sockets_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    ThreadStats ThreadLocalStorage::stats() const
+    {
+        ThreadStats s{
+            .resumed = this->stats_.resumed.load(std::memory_order_relaxed),
+            .polls = this->stats_.polls.load(std::memory_order_relaxed),
+            .poll_events = this->stats_.poll_events.load(std::memory_order_relaxed),
+            .empty_polls = this->stats_.empty_polls.load(std::memory_order_relaxed),
+            .timers_fired = this->stats_.timers_fired.load(std::memory_order_relaxed),
+            .destroyed = this->stats_.destroyed.load(std::memory_order_relaxed),
+            .run_queue_depth = this->stats_.run_queue_depth.load(std::memory_order_relaxed),
+            .local_queue_depth = this->local_q_.size_relaxed(),
+            .inbox_depth = this->inbox_depth(),
+            .live_sockets = static_cast<uint64_t>(std::max<int64_t>(0, this->live_sockets_.load(std::memory_order_relaxed))),
+            .global_queue_depth = system::this_thread::detail::st ? system::this_thread::detail::st->getSize() : 0,
+            .idle = this->idle_stats(),
+        };
+
+        const int64_t started = this->stats_.started_ns.load(std::memory_order_relaxed);
+        if (started != 0)
+        {
+            const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+            s.uptime_ns = static_cast<uint64_t>(std::max<int64_t>(now - started, 0));
+        }
+        s.blocked_ns = s.idle.park_ns;
+        const uint64_t not_running = s.idle.park_ns + s.idle.spin_ns + s.idle.yield_ns;
+        s.running_ns = s.uptime_ns > not_running ? s.uptime_ns - not_running : 0;
+        return s;
     }
 } // namespace usub::uvent::thread
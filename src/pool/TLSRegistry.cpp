@@ -13,8 +13,26 @@ namespace usub::uvent::thread
             this->tls_storage_.emplace_back(new ThreadLocalStorage{});
     }
 
+    TLSRegistry::TLSRegistry(const std::vector<system::topology::WorkerSlot>& slots)
+    {
+        const bool node_local = system::topology::node_count(slots) > 1;
+        this->tls_storage_.reserve(slots.size());
+        for (const auto& slot : slots)
+        {
+            system::topology::ScopedAffinity affinity(node_local ? slot.cpus : std::vector<int>{});
+            this->tls_storage_.emplace_back(new ThreadLocalStorage{slot.node});
+        }
+    }
+
     ThreadLocalStorage* TLSRegistry::getStorage(int index) const
     {
         return this->tls_storage_[index];
     }
+
+    int TLSRegistry::addStorage(int numa_node)
+    {
+        return static_cast<int>(this->tls_storage_.emplace_back(new ThreadLocalStorage{numa_node}));
+    }
+
+    int TLSRegistry::size() const noexcept { return static_cast<int>(this->tls_storage_.size()); }
 }
\ No newline at end of file
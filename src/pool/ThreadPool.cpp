@@ -5,38 +5,144 @@
 #include "uvent/pool/ThreadPool.h"
 
 namespace usub::uvent {
-    ThreadPool::ThreadPool(int size) : size_(size) {
+    ThreadPool::ThreadPool(int size, const system::ThreadPlacement& placement) :
+        size_(size), slots_(system::topology::plan(placement, size)), placement_(placement) {
+        this->node_local_ = system::topology::node_count(this->slots_) > 1;
         this->barrier = new std::barrier<>(size);
-        system::global::detail::tls_registry = std::make_unique<thread::TLSRegistry>(this->size_);
-        for (int i = 0; i < size - 1; i++)
+        system::global::detail::tls_registry = std::make_unique<thread::TLSRegistry>(this->slots_);
+        for (int i = 0; i < size - 1; i++) {
+            system::topology::ScopedAffinity affinity(this->node_local_ ? this->slots_[i].cpus : std::vector<int>{});
             this->threads.push_back(new system::Thread(this->barrier, i,
                                                        system::global::detail::tls_registry->getStorage(i),
-                                                       system::NEW));
+                                                       system::NEW, this->slots_[i]));
+        }
     }
 
     void ThreadPool::stop() {
+        this->stopped_.store(true, std::memory_order_release);
+        std::lock_guard lock(this->threads_mtx_);
         for (auto &thread: this->threads)
             thread->stop();
     }
 
     void ThreadPool::addThread(system::ThreadLaunchMode tlm) {
-        const int index = static_cast<int>(threads.size());
-        auto *t = new system::Thread(barrier, index,
-                                     system::global::detail::tls_registry->getStorage(this->threads.size()), tlm);
-        threads.push_back(t);
-
+        system::Thread *t = this->createThread(tlm);
         if (tlm == system::CURRENT)
             t->run_current();
     }
 
+    size_t ThreadPool::pollOnce(int timeout_ms) {
+        if (this->stopped()) {
+            // the host thread outlives the pool: it is released on its first call after stop()
+            if (this->polled_)
+                this->polled_->release_current();
+            return 0;
+        }
+        if (!this->polled_)
+            this->polled_ = this->createThread(system::CURRENT);
+        return this->polled_->poll_once(timeout_ms);
+    }
+
+    system::Thread *ThreadPool::createThread(system::ThreadLaunchMode tlm) {
+        if (tlm == system::NEW) {
+            std::lock_guard lock(this->threads_mtx_);
+            const int next = system::global::detail::tls_registry->size();
+            return this->appendThread(system::topology::plan(this->placement_, next + 1)[next]);
+        }
+        // the calling thread takes the last slot of the initial pool; threads added later come after it
+        const int index = this->size_ - 1;
+        system::topology::WorkerSlot slot;
+        {
+            std::lock_guard lock(this->threads_mtx_);
+            slot = this->slots_[index];
+        }
+        system::Thread *t;
+        {
+            system::topology::ScopedAffinity affinity(this->node_local_ ? slot.cpus : std::vector<int>{});
+            t = new system::Thread(barrier, index, system::global::detail::tls_registry->getStorage(index), tlm, slot);
+        }
+        {
+            std::lock_guard lock(this->threads_mtx_);
+            threads.push_back(t);
+        }
+        return t;
+    }
+
+    system::Thread *ThreadPool::appendThread(const system::topology::WorkerSlot &slot) {
+        auto *registry = system::global::detail::tls_registry.get();
+        system::topology::ScopedAffinity affinity(this->node_local_ ? slot.cpus : std::vector<int>{});
+        // the registry hands out the index, so storages, slots and thread indices cannot drift apart
+        const int index = registry->addStorage(slot.node);
+        this->slots_.push_back(slot);
+        // publish the storage before the thread exists, so it is visible to thieves and wakers
+        system::global::detail::thread_count.store(index + 1, std::memory_order_release);
+        auto *t = new system::Thread(nullptr, index, registry->getStorage(index), system::NEW, slot);
+        this->threads.push_back(t);
+        return t;
+    }
+
+    void ThreadPool::resize(int active) {
+        active = std::max(active, 1);
+        std::lock_guard lock(this->threads_mtx_);
+        auto *registry = system::global::detail::tls_registry.get();
+        int total = system::global::detail::thread_count.load(std::memory_order_acquire);
+
+        int current = 0;
+        for (int i = 0; i < total; ++i)
+            current += registry->getStorage(i)->retired() ? 0 : 1;
+
+        for (int i = 0; i < total && current < active; ++i) {
+            auto *storage = registry->getStorage(i);
+            if (storage->retired_.exchange(false, std::memory_order_relaxed)) {
+                ++current;
+                storage->wake_if_parked();
+            }
+        }
+
+        if (current < active) {
+            // planned once for the final size; the running threads keep the slots they were started on
+            const auto slots = system::topology::plan(this->placement_, registry->size() + active - current);
+            for (; current < active; ++current)
+                this->appendThread(slots[registry->size()]);
+            total = registry->size();
+        }
+
+        for (int i = total - 1; i >= 0 && current > active; --i) {
+            auto *storage = registry->getStorage(i);
+            if (!storage->retired_.exchange(true, std::memory_order_relaxed)) {
+                --current;
+                // let it hand its spawned tasks over right away
+                storage->wake_if_parked();
+            }
+        }
+    }
+
+    int ThreadPool::activeThreads() const {
+        auto *registry = system::global::detail::tls_registry.get();
+        const int total = system::global::detail::thread_count.load(std::memory_order_acquire);
+        int active = 0;
+        for (int i = 0; i < total; ++i)
+            active += registry->getStorage(i)->retired() ? 0 : 1;
+        return active;
+    }
+
     const thread::TLSRegistry *ThreadPool::getTLSRegistry() {
         return system::global::detail::tls_registry.get();
     }
 
+    std::vector<system::topology::WorkerSlot> ThreadPool::workerSlots() const {
+        std::lock_guard lock(this->threads_mtx_);
+        return this->slots_;
+    }
+
     ThreadPool::~ThreadPool() {
         this->stop();
-        delete this->barrier;
+        // destroyed on the host thread before it polled again
+        if (this->polled_)
+            this->polled_->release_current();
         for (auto &thread: this->threads)
             delete thread;
+        // a worker may still be leaving arrive_and_wait() until it is joined above
+        delete this->barrier;
     }
 }
@@ -51,10 +51,11 @@ namespace usub::uvent::sync
                                                        std::memory_order_relaxed);
     }
 
-    bool AsyncMutex::LockAwaiter::await_suspend(std::coroutine_handle<> h) noexcept
+    bool AsyncMutex::LockAwaiter::suspend(uvent::detail::WakeHandle h) noexcept
     {
         this->node.h = h;
         this->node.thread_id = detail::current_thread_id();
+        this->node.priority = system::this_thread::detail::cur_priority;
         for (;;)
         {
             auto s = this->m->state_.load(std::memory_order_acquire);
@@ -106,7 +107,7 @@ namespace usub::uvent::sync
             const std::uintptr_t new_state = next ? this->ptr_tag(next) : kLockedNoWaiters;
             if (this->state_.compare_exchange_weak(s, new_state, std::memory_order_acquire, std::memory_order_acquire))
             {
-                system::this_thread::detail::q->enqueue(head->h);
+                system::this_thread::detail::enqueue_ready(head->h.handle(), head->priority);
                 return;
             }
         }
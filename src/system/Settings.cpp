@@ -15,4 +15,15 @@ namespace usub::uvent::settings
     int max_pre_allocated_tmp_sockets_items = 1024;
     int max_pre_allocated_tmp_coroutines_items = 256;
     int idle_fallback_ms = 50;
+    int idle_spin_max_us = 50;
+    int idle_spin_min_us = 2;
+    int idle_yield_rounds = 2;
+    int local_queue_capacity = 256;
+    int max_lifo_slot_chain = 16;
+    int max_symmetric_transfers_per_resume = 64;
+    int max_background_tasks_per_iteration = 32;
+    int max_io_ops_per_resume = 128;
+    int trace_buffer_events = 65536;
+    int max_cached_frames_per_class = 256;
+    int blocking_pool_threads = 4;
 }
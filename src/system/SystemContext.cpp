@@ -4,6 +4,7 @@
 
 #include "uvent/system/SystemContext.h"
 #include "uvent/tasks/AwaitableFrame.h"
+#include <limits>
 
 #ifdef OS_LINUX
 #ifndef UVENT_ENABLE_IO_URING
@@ -23,6 +24,51 @@ namespace usub::uvent::system
     namespace global::detail
     {
         std::atomic<int> thread_count = -1;
+
+        void wake_parked_worker()
+        {
+            static std::atomic<uint32_t> next_victim{0};
+            const int n_threads = thread_count.load(std::memory_order_relaxed);
+            if (n_threads <= 0 || !tls_registry)
+                return;
+
+            const uint32_t start = next_victim.fetch_add(1, std::memory_order_relaxed);
+            for (int i = 0; i < n_threads; ++i)
+            {
+                const int idx = static_cast<int>((start + i) % static_cast<uint32_t>(n_threads));
+                if (idx == this_thread::detail::t_id && this_thread::detail::tls)
+                    continue;
+                auto* storage = tls_registry->getStorage(idx);
+                if (!storage->retired() && storage->wake_if_parked())
+                    return;
+            }
+        }
+
+        int pick_balanced_worker()
+        {
+            const int n_threads = thread_count.load(std::memory_order_acquire);
+            if (n_threads <= 0 || !tls_registry)
+                return -1;
+            if (n_threads == 1)
+                return tls_registry->getStorage(0)->retired() ? -1 : 0;
+
+            // xorshift, seeded per thread; only used to pick the two candidates
+            thread_local uint64_t seed = reinterpret_cast<uintptr_t>(&seed) | 1;
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            const auto n = static_cast<uint64_t>(n_threads);
+            const int a = static_cast<int>(seed % n);
+            const int b = static_cast<int>((static_cast<uint64_t>(a) + 1 + (seed >> 32) % (n - 1)) % n);
+
+            auto* sa = tls_registry->getStorage(a);
+            auto* sb = tls_registry->getStorage(b);
+            if (sa->retired())
+                return sb->retired() ? -1 : b;
+            if (sb->retired())
+                return a;
+            return sb->load() < sa->load() ? b : a;
+        }
     }
     namespace this_thread::detail
     {
@@ -37,9 +83,20 @@ namespace usub::uvent::system
         thread_local std::coroutine_handle<> cec{nullptr};
         thread_local std::unique_ptr<queue::single_thread::Queue<std::coroutine_handle<>>> q = std::make_unique<
             queue::single_thread::Queue<std::coroutine_handle<>>>();
+        thread_local std::coroutine_handle<> lifo{nullptr};
+        thread_local task::Priority lifo_priority{task::Priority::NORMAL};
+        thread_local queue::single_thread::Queue<std::coroutine_handle<>> q_lc =
+            queue::single_thread::Queue<std::coroutine_handle<>>();
+        thread_local queue::single_thread::Queue<std::coroutine_handle<>> q_bg =
+            queue::single_thread::Queue<std::coroutine_handle<>>();
+        thread_local task::Priority cur_priority{task::Priority::NORMAL};
         thread_local int t_id{-1};
+        thread_local thread::ThreadLocalStorage* tls{nullptr};
         thread_local queue::single_thread::Queue<std::coroutine_handle<>> q_c =
             queue::single_thread::Queue<std::coroutine_handle<>>();
+        thread_local queue::single_thread::Queue<ReadyTask> q_y = queue::single_thread::Queue<ReadyTask>();
+        thread_local int op_budget{std::numeric_limits<int>::max()};
+        thread_local int transfer_budget{0};
 #ifndef UVENT_ENABLE_REUSEADDR
         usub::utils::sync::QSBR g_qsbr;
 #else
@@ -4,13 +4,27 @@
 
 #include "uvent/system/Thread.h"
 #include <utility>
+#ifndef _WIN32
+#include "uvent/fs/File.h"
+#endif
 #include "uvent/net/Socket.h"
+#include "uvent/utils/trace/Trace.h"
 
 namespace usub::uvent::system
 {
+    namespace
+    {
+        /// \brief Coroutines ready on the calling thread, over all classes.
+        size_t ready_count()
+        {
+            using namespace this_thread::detail;
+            return q->size() + q_lc.size() + q_bg.size();
+        }
+    } // namespace
+
     Thread::Thread(std::barrier<>* barrier, int index, thread::ThreadLocalStorage* thread_local_storage,
-                   ThreadLaunchMode tlm) :
-        barrier(barrier), index_(index), thread_local_storage_(thread_local_storage), tlm(tlm)
+                   ThreadLaunchMode tlm, topology::WorkerSlot slot) :
+        barrier(barrier), index_(index), thread_local_storage_(thread_local_storage), tlm(tlm), slot_(std::move(slot))
     {
 #if UVENT_DEBUG
         spdlog::info("Thread #{} started", index);
@@ -18,113 +32,371 @@ namespace usub::uvent::system
         this->tmp_tasks_.resize(settings::max_pre_allocated_tasks_items);
         this->tmp_sockets_.resize(settings::max_pre_allocated_tmp_sockets_items);
         this->tmp_coroutines_.resize(settings::max_pre_allocated_tmp_coroutines_items);
+        this->steal_seed_ += static_cast<uint64_t>(index) * 0xBF58476D1CE4E5B9ull;
+        this->spin_us_ = std::max(settings::idle_spin_min_us, 1);
         if (tlm == NEW)
             this->thread_ = std::jthread([this](std::stop_token token) { this->threadFunction(token); });
     }
 
     void Thread::threadFunction(std::stop_token token)
     {
+        this->attachCurrent();
+        while (!token.stop_requested())
+            this->runIteration(-1);
+        this->detachCurrent();
+    }
+
+    void Thread::attachCurrent()
+    {
+        // pin before touching the thread-local poller, timer wheel and queues, so they are allocated node-locally
+        topology::pin_current_thread(this->slot_.cpus);
         this_thread::detail::t_id = this->index_;
-        auto& local_pl = system::this_thread::detail::pl;
+        this_thread::detail::tls = this->thread_local_storage_;
+        this->thread_local_storage_->poller_ = &system::this_thread::detail::pl;
+#if defined(OS_LINUX) && defined(UVENT_PIN_THREADS)
+        pthread_t self = pthread_self();
+        set_thread_name(std::string("uvent_worker_" + std::to_string(this->index_)), self);
+#endif
+        // threads added by Uvent::resize() start after the pool is running and have no start barrier
+        if (this->barrier)
+            this->barrier->arrive_and_wait();
+        this->thread_local_storage_->stats_.started_ns.store(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count(),
+            std::memory_order_relaxed);
+        this->processInboxQueue();
+#ifndef UVENT_ENABLE_REUSEADDR
+        system::this_thread::detail::g_qsbr.attach_current_thread();
+#endif
+    }
+
+    void Thread::detachCurrent()
+    {
+#ifndef UVENT_ENABLE_REUSEADDR
+        system::this_thread::detail::g_qsbr.detach_current_thread();
+#endif
+    }
+
+    size_t Thread::poll_once(int timeout_ms)
+    {
+        if (this->stop_source_.stop_requested())
+        {
+            this->release_current();
+            return 0;
+        }
+        if (!this->attached_)
+        {
+            this->attachCurrent();
+            this->attached_ = true;
+            this->host_ = std::this_thread::get_id();
+        }
+        const uint64_t resumed = this->counters_.resumed;
+        this->runIteration(std::max(timeout_ms, 0));
+        return static_cast<size_t>(this->counters_.resumed - resumed);
+    }
+
+    void Thread::release_current() noexcept
+    {
+        if (!this->attached_ || std::this_thread::get_id() != this->host_)
+            return;
+        this->detachCurrent();
+        // spawns from the host thread must not reach this worker's storage anymore
+        this_thread::detail::tls = nullptr;
+        this->attached_ = false;
+    }
+
+    void Thread::runIteration(int max_park_ms)
+    {
+        auto* local_tls = this->thread_local_storage_;
         auto& local_wh = system::this_thread::detail::wh;
         auto& local_q = system::this_thread::detail::q;
         auto& local_q_c = system::this_thread::detail::q_c;
+        auto& local_q_y = system::this_thread::detail::q_y;
 #ifndef UVENT_ENABLE_REUSEADDR
+        auto& local_pl = system::this_thread::detail::pl;
         auto& local_g_qsbr = system::this_thread::detail::g_qsbr;
 #else
         auto& local_q_sh = system::this_thread::detail::q_sh;
 #endif
-#if defined(OS_LINUX) && defined(UVENT_PIN_THREADS)
-        pthread_t self = pthread_self();
-        pin_thread_to_core(this->index_);
-        set_thread_name(std::string("uvent_worker_" + std::to_string(this->index_)), self);
-#endif
-        this->barrier->arrive_and_wait();
-        this->processInboxQueue();
         using namespace system::this_thread::detail;
-#ifndef UVENT_ENABLE_REUSEADDR
-        local_g_qsbr.attach_current_thread();
+#if !defined(UVENT_ENABLE_IO_URING) && !defined(_WIN32)
+        // file operations issued during the previous iteration go to the blocking pool as one job
+        fs::detail::flush_pending();
 #endif
-        while (!token.stop_requested())
+        auto next_timeout = local_wh.getNextTimeout();
+        bool is_idle = next_timeout != 0 && local_q->empty() && local_tls->local_q_.empty_relaxed() &&
+            q_lc.empty() && q_bg.empty();
+        // an embedding loop gets its time back instead of spinning
+        if (is_idle && max_park_ms < 0 && this->spinBeforePark())
+            is_idle = false;
+        int park_timeout = (next_timeout > 0 && next_timeout < settings::idle_fallback_ms)
+            ? next_timeout
+            : settings::idle_fallback_ms;
+        if (max_park_ms >= 0)
         {
+            park_timeout = std::min(park_timeout, max_park_ms);
+            is_idle = is_idle && park_timeout > 0;
+        }
 #ifndef UVENT_ENABLE_REUSEADDR
-            if (local_pl.try_lock())
-            {
-                auto next_timeout = local_wh.getNextTimeout();
-                local_pl.poll((local_q->empty()) ? (next_timeout > 0) ? next_timeout : settings::idle_fallback_ms : 0);
-                local_pl.unlock();
-            }
-            else if (local_q->empty() && local_q_c.empty())
-            {
-                auto next_timeout = local_wh.getNextTimeout();
-                local_pl.lock_poll((local_q->empty()) ? (next_timeout > 0) ? next_timeout : settings::idle_fallback_ms
-                                                      : 0);
-            }
+        if (local_pl.try_lock())
+        {
+            this->parkOrPoll(is_idle ? park_timeout : 0);
+            local_pl.unlock();
+        }
+        else if (is_idle && local_q_c.empty())
+            this->parkOrPoll(park_timeout, true);
 #else
-            auto next_timeout = local_wh.getNextTimeout();
-            local_pl.poll(local_q->empty() ? (next_timeout > 0) ? next_timeout : settings::idle_fallback_ms : 0);
+        this->parkOrPoll(is_idle ? park_timeout : 0);
 #endif
-            size_t n;
-            while ((n = local_q->dequeue_bulk(this->tmp_tasks_.data(), this->tmp_tasks_.size())) > 0)
+        // every entry of the class queues carries the class it was made ready in, frames are not read here
+        std::coroutine_handle<> h;
+        size_t n;
+        for (;;)
+        {
+            while (q_lc.dequeue(h))
+                this->runTask(h, task::Priority::LATENCY_CRITICAL);
+            if ((n = local_q->dequeue_bulk(this->tmp_tasks_.data(), this->tmp_tasks_.size())) == 0)
             {
-                for (size_t i = 0; i < n; ++i)
-                {
-                    auto& elem = this->tmp_tasks_[i];
-                    if (!elem)
-                        continue;
-
-                    auto c = std::coroutine_handle<detail::AwaitableFrameBase>::from_address(elem.address());
-                    if (c)
-                    {
-                        this_thread::detail::cec = c;
-#if UVENT_DEBUG
-                        spdlog::debug("Prev address: {}", static_cast<void*>(c.address()));
-#endif
-                        if (!c.done())
-                        {
-#if UVENT_DEBUG
-                            spdlog::info("Coroutine resumed: {}", c.address());
-#endif
-                            c.resume();
-                        }
-                    }
-                }
+                // spawned tasks are runtime frames: sort them into their classes and go around
+                n = local_tls->local_q_.try_pop_bulk(this->tmp_tasks_.data(), LOCAL_POP_BATCH);
+                if (n == 0)
+                    break;
+                this->enqueueFrames(n);
+                continue;
             }
-#ifndef UVENT_ENABLE_REUSEADDR
-            if (local_wh.mtx.try_lock())
+            for (size_t i = 0; i < n; ++i)
             {
-                local_wh.tick();
-                local_wh.mtx.unlock();
+                // latency-critical tasks made ready by this batch do not wait for the rest of it
+                while (q_lc.dequeue(h))
+                    this->runTask(h, task::Priority::LATENCY_CRITICAL);
+                this->runTask(this->tmp_tasks_[i], task::Priority::NORMAL);
             }
+        }
+
+        for (int i = 0; i < settings::max_background_tasks_per_iteration && q_bg.dequeue(h); ++i)
+            this->runTask(h, task::Priority::BACKGROUND);
+
+        ReadyTask yielded;
+        while (local_q_y.dequeue(yielded))
+            enqueue_ready(yielded.h, yielded.priority);
+#ifndef UVENT_ENABLE_REUSEADDR
+        if (local_wh.mtx.try_lock())
+        {
+            this->counters_.timers_fired += local_wh.tick();
+            local_wh.mtx.unlock();
+        }
 #else
-            local_wh.tick();
+        this->counters_.timers_fired += local_wh.tick();
 #endif
-            if (st->getSize() > 0)
-                st->dequeue_bulk(q.get());
+        if (local_tls->retired_.load(std::memory_order_relaxed))
+            this->handOffSharedWork();
+        else if (st->getSize() > 0)
+            this->enqueueFrames(
+                st->dequeue_bulk(this->tmp_tasks_.data(), std::min(this->tmp_tasks_.size(), SHARED_POP_BATCH)));
+        else if (local_q->empty() && local_tls->local_q_.empty_relaxed())
+            this->stealTasks();
 
-            const size_t n_coroutines =
-                local_q_c.dequeue_bulk(this->tmp_coroutines_.data(), this->tmp_coroutines_.size());
-            for (size_t i = 0; i < n_coroutines; i++)
-            {
-                auto c_temp =
-                    std::coroutine_handle<detail::AwaitableFrameBase>::from_address(this->tmp_coroutines_[i].address());
+        const size_t n_coroutines =
+            local_q_c.dequeue_bulk(this->tmp_coroutines_.data(), this->tmp_coroutines_.size());
+        for (size_t i = 0; i < n_coroutines; i++)
+        {
+            auto c_temp =
+                std::coroutine_handle<detail::AwaitableFrameBase>::from_address(this->tmp_coroutines_[i].address());
 #ifdef UVENT_DEBUG
-                spdlog::info("Coroutine destroyed in auxiliary loop: {}", this->tmp_coroutines_[i].address());
+            spdlog::info("Coroutine destroyed in auxiliary loop: {}", this->tmp_coroutines_[i].address());
 #endif
-                c_temp.destroy();
-            }
+            c_temp.destroy();
+        }
+        this->counters_.destroyed += n_coroutines;
 #ifndef UVENT_ENABLE_REUSEADDR
-            local_g_qsbr.quiesce_tick();
+        local_g_qsbr.quiesce_tick();
 #else
-            const size_t n_sockets = local_q_sh.dequeue_bulk(this->tmp_sockets_.data(), this->tmp_sockets_.size());
-            for (size_t i = 0; i < n_sockets; ++i)
-                delete this->tmp_sockets_[i];
+        const size_t n_sockets = local_q_sh.dequeue_bulk(this->tmp_sockets_.data(), this->tmp_sockets_.size());
+        for (size_t i = 0; i < n_sockets; ++i)
+            delete this->tmp_sockets_[i];
+#endif
+        this->processInboxQueue();
+        this->publishStats();
+    }
+
+    bool Thread::hasPendingWork() const
+    {
+        using namespace this_thread::detail;
+        auto* tls = this->thread_local_storage_;
+        return !q->empty() || !tls->local_q_.empty_relaxed() || !q_lc.empty() || !q_bg.empty() ||
+            tls->is_added_new_.load(std::memory_order_relaxed) ||
+            (st->getSize() > 0 && !tls->retired_.load(std::memory_order_relaxed));
+    }
+
+    void Thread::handOffSharedWork()
+    {
+        // spawned tasks are not bound to this thread yet; tasks in q are (their sockets live in our poller)
+        auto& local_q = this->thread_local_storage_->local_q_;
+        size_t n, moved = 0;
+        while ((n = local_q.try_pop_bulk(this->tmp_tasks_.data(), this->tmp_tasks_.size())) > 0)
+        {
+            for (size_t i = 0; i < n; ++i)
+                this_thread::detail::st->enqueue(this->tmp_tasks_[i]);
+            moved += n;
+        }
+        if (moved > 0)
+            global::detail::notify_parked_worker();
+    }
+
+    bool Thread::spinBeforePark()
+    {
+        if (settings::idle_spin_max_us <= 0)
+            return false;
+
+        auto& stats = this->thread_local_storage_->idle_stats_;
+        const auto spin_start = std::chrono::steady_clock::now();
+        const auto spin_deadline = spin_start + std::chrono::microseconds(this->spin_us_);
+        bool found = false;
+
+        do
+        {
+#ifdef UVENT_ENABLE_REUSEADDR
+            if (this->pollCounted(0, false))
+            {
+                found = true;
+                break;
+            }
 #endif
-            this->processInboxQueue();
+            if (this->hasPendingWork() || this->stealTasks())
+            {
+                found = true;
+                break;
+            }
+            cpu_relax();
         }
-#ifndef UVENT_ENABLE_REUSEADDR
-        local_g_qsbr.detach_current_thread();
+        while (std::chrono::steady_clock::now() < spin_deadline);
+
+        const auto spin_end = std::chrono::steady_clock::now();
+        stats.spin_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(spin_end - spin_start).count(),
+                                std::memory_order_relaxed);
+        if (found)
+        {
+            // work keeps arriving within the spin window: spin longer next time
+            this->spin_us_ = std::min(this->spin_us_ * 2, std::max(settings::idle_spin_max_us, 1));
+            stats.spin_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        for (int i = 0; i < settings::idle_yield_rounds && !found; ++i)
+        {
+            std::this_thread::yield();
+            found = this->hasPendingWork();
+        }
+
+        stats.yield_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - spin_end).count(),
+            std::memory_order_relaxed);
+        if (found)
+        {
+            stats.yield_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // nothing arrived: the thread is going to park, so the next spin is shorter
+        this->spin_us_ = std::max(this->spin_us_ / 2, std::max(1, settings::idle_spin_min_us));
+        return false;
+    }
+
+    void Thread::parkOrPoll(int timeout, bool lock)
+    {
+        auto* tls = this->thread_local_storage_;
+        if (timeout == 0)
+        {
+            this->pollCounted(0, lock);
+            return;
+        }
+
+        // announce the park before the last look at the queues; producers check parked_ after publishing work
+        tls->parked_.store(true, std::memory_order_relaxed);
+        global::detail::parked_threads.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->hasPendingWork())
+            timeout = 0;
+
+        const auto park_start = std::chrono::steady_clock::now();
+        this->pollCounted(timeout, lock);
+        tls->parked_.store(false, std::memory_order_relaxed);
+        global::detail::parked_threads.fetch_sub(1, std::memory_order_relaxed);
+
+        auto& stats = this->thread_local_storage_->idle_stats_;
+        stats.park_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now() - park_start)
+                                    .count(),
+                                std::memory_order_relaxed);
+        stats.parks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool Thread::pollCounted(int timeout, bool lock)
+    {
+        auto& local_pl = this_thread::detail::pl;
+        const size_t before = ready_count();
+        if (lock)
+            local_pl.lock_poll(timeout);
+        else
+            local_pl.poll(timeout);
+        const size_t woken = ready_count() - before;
+
+        ++this->counters_.polls;
+        this->counters_.poll_events += woken;
+        if (woken == 0)
+            ++this->counters_.empty_polls;
+        return woken > 0;
+    }
+
+    void Thread::publishStats()
+    {
+        // single writer: plain stores are enough, readers only need each value to be untorn
+        auto& s = this->thread_local_storage_->stats_;
+        s.resumed.store(this->counters_.resumed, std::memory_order_relaxed);
+        s.polls.store(this->counters_.polls, std::memory_order_relaxed);
+        s.poll_events.store(this->counters_.poll_events, std::memory_order_relaxed);
+        s.empty_polls.store(this->counters_.empty_polls, std::memory_order_relaxed);
+        s.timers_fired.store(this->counters_.timers_fired, std::memory_order_relaxed);
+        s.destroyed.store(this->counters_.destroyed, std::memory_order_relaxed);
+        s.run_queue_depth.store(ready_count(), std::memory_order_relaxed);
+    }
+
+    void Thread::runTask(std::coroutine_handle<> h, task::Priority priority)
+    {
+        using namespace this_thread::detail;
+        this->resumeTask(h, priority);
+        // continuations handed off by the task just resumed run while their frames are still hot,
+        // unless that would hold back a latency-critical task made ready meanwhile
+        for (int chain = 0; lifo && chain < settings::max_lifo_slot_chain &&
+             (lifo_priority == task::Priority::LATENCY_CRITICAL || q_lc.empty());
+             ++chain)
+            this->resumeTask(std::exchange(lifo, nullptr), lifo_priority);
+        if (lifo)
+            enqueue_ready(std::exchange(lifo, nullptr), lifo_priority);
+    }
+
+    void Thread::resumeTask(std::coroutine_handle<> c, task::Priority priority)
+    {
+        if (c)
+        {
+            this_thread::detail::cec = c;
+            this_thread::detail::cur_priority = priority;
+            this_thread::detail::op_budget = settings::max_io_ops_per_resume;
+            this_thread::detail::transfer_budget = settings::max_symmetric_transfers_per_resume;
+#if UVENT_DEBUG
+            spdlog::debug("Prev address: {}", static_cast<void*>(c.address()));
 #endif
+            if (!c.done())
+            {
+#if UVENT_DEBUG
+                spdlog::info("Coroutine resumed: {}", c.address());
+#endif
+                ++this->counters_.resumed;
+                UVENT_TRACE_SCOPE(RESUME, c.address(), priority);
+                c.resume();
+            }
+            this_thread::detail::cur_priority = task::Priority::NORMAL;
+        }
     }
 
     void Thread::processInboxQueue()
@@ -134,21 +406,63 @@ namespace usub::uvent::system
         if (!tls->is_added_new_.exchange(false, std::memory_order_acq_rel))
             return;
 
-        constexpr size_t BATCH = 64;
-        std::coroutine_handle<> buf[BATCH];
-
-        for (;;)
+        uint64_t n = 0;
+        while (auto* frame = tls->inbox_q_.pop())
         {
-            size_t n = tls->inbox_q_.try_dequeue_bulk(buf, BATCH);
-            if (n == 0)
-                break;
+            system::this_thread::detail::enqueue_frame(frame->get_coroutine_handle());
+            ++n;
+        }
+        if (n != 0)
+            tls->inbox_popped_.store(tls->inbox_popped_.load(std::memory_order_relaxed) + n,
+                                     std::memory_order_release);
 
-            for (size_t i = 0; i < n; ++i)
+        // a producer is between its exchange and its link: look again on the next iteration
+        if (!tls->inbox_q_.empty())
+            tls->is_added_new_.store(true, std::memory_order_release);
+    }
+
+    void Thread::enqueueFrames(size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            this_thread::detail::enqueue_frame(
+                std::coroutine_handle<detail::AwaitableFrameBase>::from_address(this->tmp_tasks_[i].address()));
+    }
+
+    bool Thread::stealTasks()
+    {
+        const int n_threads = global::detail::thread_count.load(std::memory_order_relaxed);
+        if (n_threads <= 1 || this->thread_local_storage_->retired_.load(std::memory_order_relaxed))
+            return false;
+
+        // xorshift, only used to spread thieves over different victims
+        this->steal_seed_ ^= this->steal_seed_ << 13;
+        this->steal_seed_ ^= this->steal_seed_ >> 7;
+        this->steal_seed_ ^= this->steal_seed_ << 17;
+        const int start = static_cast<int>(this->steal_seed_ % static_cast<uint64_t>(n_threads));
+        const int own_node = this->slot_.node;
+
+        // first pass: victims on our NUMA node only; second pass: everyone else
+        for (int pass = (own_node >= 0 ? 0 : 1); pass < 2; ++pass)
+        {
+            for (int i = 0; i < n_threads; ++i)
             {
-                if (buf[i])
-                    system::this_thread::detail::q->enqueue(buf[i]);
+                const int victim = (start + i) % n_threads;
+                if (victim == this->index_)
+                    continue;
+
+                auto* storage = global::detail::tls_registry->getStorage(victim);
+                if ((pass == 0) != (storage->numa_node_ == own_node) || storage->local_q_.empty_relaxed())
+                    continue;
+
+                const size_t n = storage->steal_tasks(this->tmp_tasks_.data(), this->tmp_tasks_.size());
+                if (n > 0)
+                {
+                    this->enqueueFrames(n);
+                    return true;
+                }
             }
         }
+        return false;
     }
 
     void Thread::run_current() { threadFunction(this->stop_source_.get_token()); }
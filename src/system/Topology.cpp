@@ -0,0 +1,189 @@
+//
+// Created by root on 10/16/26.
+//
+
+#include "uvent/system/Topology.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include "uvent/system/Defines.h"
+
+#ifdef OS_LINUX
+#include <filesystem>
+#include <fstream>
+#include <string>
+#endif
+
+namespace usub::uvent::system::topology
+{
+#ifdef OS_LINUX
+    namespace
+    {
+        int read_int(const std::string& path, int fallback)
+        {
+            std::ifstream in(path);
+            int value;
+            if (in >> value)
+                return value;
+            return fallback;
+        }
+    } // namespace
+
+    int node_of_cpu(int cpu)
+    {
+        std::error_code ec;
+        const std::filesystem::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+        {
+            const auto name = entry.path().filename().string();
+            if (name.size() > 4 && name.starts_with("node") &&
+                std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+                return std::stoi(name.substr(4));
+        }
+        return 0;
+    }
+
+    std::vector<CpuInfo> allowed_cpus()
+    {
+        std::vector<CpuInfo> cpus;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0)
+            return cpus;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (!CPU_ISSET(cpu, &set))
+                continue;
+            const std::string topo = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            cpus.push_back(CpuInfo{cpu, read_int(topo + "core_id", cpu), read_int(topo + "physical_package_id", 0),
+                                   node_of_cpu(cpu)});
+        }
+        return cpus;
+    }
+
+    bool pin_current_thread(const std::vector<int>& cpus)
+    {
+        if (cpus.empty())
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        {
+            std::lock_guard<std::mutex> lock(cout_mutex);
+            std::cerr << "Failed to set affinity for cpu " << cpus.front()
+                      << (cpus.size() > 1 ? " (+" + std::to_string(cpus.size() - 1) + ")" : "") << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    ScopedAffinity::ScopedAffinity(const std::vector<int>& cpus)
+    {
+        if (cpus.empty())
+            return;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+            return;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &set))
+                this->saved_.push_back(cpu);
+
+        this->active_ = pin_current_thread(cpus);
+    }
+
+    ScopedAffinity::~ScopedAffinity()
+    {
+        if (this->active_)
+            pin_current_thread(this->saved_);
+    }
+#else
+    int node_of_cpu(int) { return -1; }
+
+    std::vector<CpuInfo> allowed_cpus() { return {}; }
+
+    bool pin_current_thread(const std::vector<int>&) { return false; }
+
+    ScopedAffinity::ScopedAffinity(const std::vector<int>&) {}
+
+    ScopedAffinity::~ScopedAffinity() = default;
+#endif
+
+    std::vector<WorkerSlot> plan(const ThreadPlacement& placement, int thread_count)
+    {
+        std::vector<WorkerSlot> slots(static_cast<size_t>(std::max(thread_count, 0)));
+        if (placement.policy == PlacementPolicy::NONE || slots.empty())
+            return slots;
+
+        if (placement.policy == PlacementPolicy::CPU_LIST && !placement.cpus.empty())
+        {
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                const int cpu = placement.cpus[i % placement.cpus.size()];
+                slots[i] = WorkerSlot{{cpu}, node_of_cpu(cpu)};
+            }
+            return slots;
+        }
+
+        const auto allowed = allowed_cpus();
+        if (allowed.empty())
+            return slots;
+
+        switch (placement.policy)
+        {
+        case PlacementPolicy::PHYSICAL_CORES:
+            {
+                // first sibling of every core, then the second ones, ...
+                std::map<std::pair<int, int>, int> seen;
+                std::vector<std::pair<int, const CpuInfo*>> order;
+                for (const auto& c : allowed)
+                    order.emplace_back(seen[{c.package, c.core}]++, &c);
+                std::stable_sort(order.begin(), order.end(),
+                                 [](const auto& a, const auto& b) { return a.first < b.first; });
+                for (size_t i = 0; i < slots.size(); ++i)
+                {
+                    const auto* c = order[i % order.size()].second;
+                    slots[i] = WorkerSlot{{c->cpu}, c->node};
+                }
+                break;
+            }
+        case PlacementPolicy::NUMA_NODES:
+            {
+                std::map<int, std::vector<int>> nodes;
+                for (const auto& c : allowed)
+                    nodes[c.node].push_back(c.cpu);
+                std::vector<std::pair<int, std::vector<int>>> groups(nodes.begin(), nodes.end());
+                for (size_t i = 0; i < slots.size(); ++i)
+                {
+                    const auto& g = groups[i * groups.size() / slots.size()];
+                    slots[i] = WorkerSlot{g.second, g.first};
+                }
+                break;
+            }
+        default:
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                const auto& c = allowed[i % allowed.size()];
+                slots[i] = WorkerSlot{{c.cpu}, c.node};
+            }
+            break;
+        }
+        return slots;
+    }
+
+    int node_count(const std::vector<WorkerSlot>& slots)
+    {
+        std::set<int> nodes;
+        for (const auto& s : slots)
+            if (s.node >= 0)
+                nodes.insert(s.node);
+        return static_cast<int>(nodes.size());
+    }
+} // namespace usub::uvent::system::topology
@@ -7,6 +7,30 @@
 
 namespace usub::uvent::detail
 {
+    namespace
+    {
+        // join states kept in prev_ of a joinable frame; any other value is the waiting coroutine
+        char join_pending_tag;
+        char join_detached_tag;
+        char join_done_tag;
+
+        std::coroutine_handle<> join_state(char& tag) noexcept { return std::coroutine_handle<>::from_address(&tag); }
+
+        task::Awaitable<void> resume_foreign(std::coroutine_handle<> h)
+        {
+            h.resume();
+            co_return;
+        }
+    } // namespace
+
+    std::coroutine_handle<AwaitableFrameBase> wrap_foreign(std::coroutine_handle<> h, task::Priority priority)
+    {
+        auto* frame = resume_foreign(h).get_promise();
+        // the wrapped coroutine has no class of its own: it runs in the one recorded by the caller
+        frame->set_priority(priority);
+        return frame->get_coroutine_handle();
+    }
+
     void AwaitableFrameBase::destroy(DestroyingPolicy policy)
     {
         if (policy == FORCED)
@@ -14,7 +38,8 @@ namespace usub::uvent::detail
             AwaitableFrameBase* current = this;
             while (current)
             {
-                auto prev_handle = std::exchange(current->prev_, {});
+                // a joinable frame has no caller, its prev_ holds the join state
+                auto prev_handle = current->joinable_ ? std::coroutine_handle<>{} : std::exchange(current->prev_, {});
                 auto* prev = prev_handle
                                  ? &std::coroutine_handle<AwaitableFrameBase>::from_address(prev_handle.address()).
                                  promise()
@@ -26,63 +51,150 @@ namespace usub::uvent::detail
         else std::coroutine_handle<AwaitableFrameBase>::from_promise(*this).destroy();
     }
 
-    void AwaitableFrameBase::resume()
-    {
-        this->coro_.resume();
-    }
-
-    void
-    AwaitableFrameBase::set_calling_coroutine(std::coroutine_handle<> h)
+    AwaitableFrameBase::~AwaitableFrameBase()
     {
-        this->prev_ = h;
+        // destroyed before resuming to take the result of a completed child: nobody else will destroy it
+        if (auto* child = std::exchange(this->owned_child_, nullptr))
+            child->destroy();
+        // reaped by its caller, or destroyed with it above: the caller's slot must not outlive the frame
+        if (this->owned_by_awaiter_ && this->caller_is_frame_)
+            std::coroutine_handle<AwaitableFrameBase>::from_address(this->prev_.address()).promise().owned_child_ =
+                nullptr;
     }
 
-    std::coroutine_handle<> AwaitableFrameBase::get_coroutine_handle()
+    void AwaitableFrameBase::resume()
     {
-        return this->coro_;
+        this->get_coroutine_handle().resume();
     }
 
     std::coroutine_handle<> AwaitableFrameBase::get_calling_coroutine()
     {
-        return this->prev_;
+        // prev_ of a joinable frame is a join state tag, not a coroutine
+        return this->joinable_ ? std::coroutine_handle<>{} : this->prev_;
     }
 
     void AwaitableFrameBase::push_frame_into_task_queue(std::coroutine_handle<> h)
     {
-        system::this_thread::detail::q->enqueue(h);
+        using namespace system::this_thread::detail;
+        // only worker loops drain the LIFO slot; a displaced handle keeps its place at the tail of its class.
+        // Background work never takes the slot, it would run ahead of its quota.
+        if (tls && cur_priority != task::Priority::BACKGROUND)
+        {
+            const auto displaced_priority = std::exchange(lifo_priority, cur_priority);
+            if (auto displaced = std::exchange(lifo, h))
+                enqueue_ready(displaced, displaced_priority);
+        }
+        else
+            enqueue_ready(h, cur_priority);
 #if UVENT_DEBUG
         spdlog::trace("Coroutine returned into local queue: {}", h.address());
 #endif
     }
 
-    AwaitableFrameBase::AwaitableFrameBase() {
-        this->t_id_ = system::this_thread::detail::t_id;
+    std::coroutine_handle<> AwaitableFrameBase::transfer_to(std::coroutine_handle<> h)
+    {
+        using namespace system::this_thread::detail;
+        // without a guaranteed tail call every direct transfer nests a resume on the stack, so the chain is bounded
+        if (transfer_budget > 0)
+        {
+            --transfer_budget;
+            cec = h;
+            return h;
+        }
+        push_frame_into_task_queue(h);
+        return std::noop_coroutine();
     }
 
-    bool AwaitableFrameBase::await_ready()
+    std::coroutine_handle<> AwaitableFrameBase::final_transfer() noexcept
     {
-        return false;
+        if (this->joinable_)
+            return this->final_join();
+        if (this->prev_)
+        {
+            // the caller reads the result in await_resume() and destroys the frame right after; prev_ stays as the
+            // link to a runtime caller, which destroys the frame itself if it is torn down before resuming
+            this->owned_by_awaiter_ = true;
+            if (this->caller_is_frame_)
+                std::coroutine_handle<AwaitableFrameBase>::from_address(this->prev_.address()).promise().owned_child_ =
+                    this;
+            return transfer_to(this->prev_);
+        }
+        this->push_frame_to_be_destroyed();
+        return std::noop_coroutine();
     }
 
-    void AwaitableFrameBase::push_frame_to_be_destroyed()
+    void AwaitableFrameBase::join_start() noexcept
+    {
+        this->joinable_ = true;
+        this->prev_ = join_state(join_pending_tag);
+    }
+
+    bool AwaitableFrameBase::join_done() noexcept
+    {
+        return std::atomic_ref(this->prev_).load(std::memory_order_acquire) == join_state(join_done_tag);
+    }
+
+    bool AwaitableFrameBase::join_wait(std::coroutine_handle<AwaitableFrameBase> waiter) noexcept
     {
-        system::this_thread::detail::q_c.enqueue(this->coro_);
+        // the waiter is suspended and ours until the exchange below publishes it
+        waiter.promise().set_thread_id(system::this_thread::detail::t_id);
+        auto expected = join_state(join_pending_tag);
+        return std::atomic_ref(this->prev_).compare_exchange_strong(expected, std::coroutine_handle<>{waiter}, std::memory_order_acq_rel,
+                                                                     std::memory_order_acquire);
     }
 
-    void AwaitableFrameBase::set_next_coroutine(std::coroutine_handle<> h)
+    void AwaitableFrameBase::join_detach() noexcept
     {
-        this->next_ = h;
+        // pending, or a waiter being torn down with the handle: either way nobody will join anymore
+        std::atomic_ref state(this->prev_);
+        auto expected = state.load(std::memory_order_acquire);
+        while (expected != join_state(join_done_tag))
+            if (state.compare_exchange_weak(expected, join_state(join_detached_tag), std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+                return;
+        this->destroy(); // already completed
     }
 
-    std::coroutine_handle<> AwaitableFrameBase::get_next_coroutine()
+    std::coroutine_handle<> AwaitableFrameBase::final_join() noexcept
     {
-        return this->next_;
+        // the frame may be destroyed by its joiner as soon as the state says done: no member access after this
+        const auto prev = std::atomic_ref(this->prev_).exchange(join_state(join_done_tag), std::memory_order_acq_rel);
+        if (prev == join_state(join_pending_tag))
+            return std::noop_coroutine();
+        if (prev == join_state(join_detached_tag))
+        {
+            // nobody will join: the frame is ours again
+            this->push_frame_to_be_destroyed();
+            return std::noop_coroutine();
+        }
+
+        using namespace system;
+        // any other value was stored by join_wait(), which takes runtime frames only
+        const auto waiter = std::coroutine_handle<AwaitableFrameBase>::from_address(prev.address());
+        const int tid = waiter.promise().get_thread_id();
+        if (tid == this_thread::detail::t_id && this_thread::detail::tls)
+            return transfer_to(waiter);
+        if (tid >= 0 && tid < global::detail::thread_count.load(std::memory_order_acquire))
+            global::detail::tls_registry->getStorage(tid)->push_task_inbox(waiter);
+        else
+            co_spawn(waiter);
+        return std::noop_coroutine();
+    }
+
+    AwaitableFrameBase::AwaitableFrameBase() {
+        this->t_id_ = system::this_thread::detail::t_id;
+        this->priority_ = system::this_thread::detail::cur_priority;
+    }
+
+    void AwaitableFrameBase::push_frame_to_be_destroyed()
+    {
+        system::this_thread::detail::q_c.enqueue(this->get_coroutine_handle());
     }
 
     AwaitableFrame<void>::~AwaitableFrame()
     {
 #if UVENT_DEBUG
-        spdlog::trace("Destroying coroutine {}", this->coro_.address());
+        spdlog::trace("Destroying coroutine {}", this->get_coroutine_handle().address());
 #endif
     }
 
@@ -91,19 +203,11 @@ namespace usub::uvent::detail
         return {};
     }
 
-    std::suspend_always AwaitableFrame<void>::final_suspend() noexcept
+    FinalAwaiter AwaitableFrame<void>::final_suspend() noexcept
     {
 #if UVENT_DEBUG
-        spdlog::trace("Entering final_suspend for void coroutine {}", this->coro_.address());
+        spdlog::trace("Entering final_suspend for void coroutine {}", this->get_coroutine_handle().address());
 #endif
-        if (this->prev_)
-        {
-            auto c_temp = std::coroutine_handle<::usub::uvent::detail::AwaitableFrameBase>::from_address(
-                this->prev_.address());
-            AwaitableFrame<void>::push_frame_into_task_queue(static_cast<std::coroutine_handle<>>(c_temp));
-            std::exchange(this->prev_, nullptr);
-        }
-        this->push_frame_to_be_destroyed();
         return {};
     }
 
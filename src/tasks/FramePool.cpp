@@ -0,0 +1,171 @@
+//
+// Created by root on 10/16/26.
+//
+
+#include "uvent/tasks/FramePool.h"
+#include <new>
+#include <utility>
+#include "uvent/system/Settings.h"
+
+namespace usub::uvent::detail
+{
+    namespace
+    {
+        /// \brief Owns the calling thread's pool; retires it when the thread exits.
+        struct LocalPoolHolder
+        {
+            FramePool* pool{nullptr};
+
+            ~LocalPoolHolder()
+            {
+                // frees that still happen on this thread go through the remote path from now on
+                if (this->pool)
+                    std::exchange(this->pool, nullptr)->retire();
+            }
+        };
+
+        thread_local LocalPoolHolder local_pool;
+    } // namespace
+
+    FramePool::FreeNode FramePool::CLOSED{nullptr};
+
+    FramePool& FramePool::local()
+    {
+        if (!local_pool.pool)
+            local_pool.pool = new FramePool();
+        return *local_pool.pool;
+    }
+
+    void* FramePool::allocate(size_t size)
+    {
+        const size_t total = size + sizeof(BlockHeader);
+        if (total > MAX_POOLED_SIZE)
+        {
+            auto* block = static_cast<BlockHeader*>(::operator new(total));
+            block->owner = nullptr;
+            block->size_class = UNPOOLED;
+            return block + 1;
+        }
+        return local().allocate_local(static_cast<uint32_t>((total - 1) / GRANULARITY));
+    }
+
+    void FramePool::deallocate(void* p) noexcept
+    {
+        if (!p)
+            return;
+
+        auto* block = static_cast<BlockHeader*>(p) - 1;
+        if (block->size_class == UNPOOLED)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        FramePool* owner = block->owner;
+        if (local_pool.pool == owner)
+            owner->free_local(block);
+        else
+            owner->free_remote(block);
+    }
+
+    void* FramePool::allocate_local(uint32_t size_class)
+    {
+        if (!this->free_[size_class] && this->remote_.load(std::memory_order_relaxed))
+            this->drain_remote();
+
+        BlockHeader* block;
+        if (auto* node = this->free_[size_class])
+        {
+            this->free_[size_class] = node->next;
+            --this->cached_[size_class];
+            block = reinterpret_cast<BlockHeader*>(node);
+        }
+        else
+        {
+            block = static_cast<BlockHeader*>(::operator new(class_bytes(size_class)));
+            this->blocks_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        block->owner = this;
+        block->size_class = size_class;
+        return block + 1;
+    }
+
+    void FramePool::free_local(BlockHeader* block) noexcept
+    {
+        const uint32_t size_class = block->size_class;
+        if (this->cached_[size_class] >= static_cast<uint32_t>(settings::max_cached_frames_per_class))
+        {
+            this->release_block(block);
+            return;
+        }
+
+        auto* node = reinterpret_cast<FreeNode*>(block);
+        node->next = this->free_[size_class];
+        this->free_[size_class] = node;
+        ++this->cached_[size_class];
+    }
+
+    void FramePool::free_remote(BlockHeader* block) noexcept
+    {
+        // the size class stays in the header; only the first word is reused as the link
+        auto* node = reinterpret_cast<FreeNode*>(block);
+        FreeNode* head = this->remote_.load(std::memory_order_relaxed);
+        do
+        {
+            // the owner has exited: nobody would drain the stack any more
+            if (head == &CLOSED)
+            {
+                this->release_block(block);
+                return;
+            }
+            node->next = head;
+        }
+        while (!this->remote_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void FramePool::release_block(BlockHeader* block) noexcept
+    {
+        ::operator delete(block);
+        // the last block of a retired pool takes the pool with it
+        if (this->blocks_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    void FramePool::drain_remote() noexcept
+    {
+        // only the owner takes the whole stack at once, so there is no ABA on pop
+        FreeNode* node = this->remote_.exchange(nullptr, std::memory_order_acquire);
+        while (node)
+        {
+            FreeNode* next = node->next;
+            auto* block = reinterpret_cast<BlockHeader*>(node);
+            this->free_local(block);
+            node = next;
+        }
+    }
+
+    void FramePool::retire() noexcept
+    {
+        // closing the stack and taking what was pushed is one step: a later push sees CLOSED and frees its block
+        FreeNode* node = this->remote_.exchange(&CLOSED, std::memory_order_acquire);
+        while (node)
+        {
+            FreeNode* next = node->next;
+            this->release_block(reinterpret_cast<BlockHeader*>(node));
+            node = next;
+        }
+        for (auto& head : this->free_)
+        {
+            while (head)
+            {
+                FreeNode* next = head->next;
+                this->release_block(reinterpret_cast<BlockHeader*>(head));
+                head = next;
+            }
+        }
+        // drop the reference of the owning thread; blocks still alive elsewhere keep the pool
+        if (this->blocks_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+} // namespace usub::uvent::detail
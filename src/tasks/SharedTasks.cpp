@@ -12,23 +12,85 @@ namespace usub::uvent::task
         this->detachedTasks = std::make_unique<queue::concurrent::MPMCQueue<std::coroutine_handle<>>>();
     }
 
-    void SharedTasks::enqueue(std::coroutine_handle<>& task) { this->detachedTasks->try_enqueue(task); }
+    void SharedTasks::enqueue(std::coroutine_handle<>& task)
+    {
+        if (!this->detachedTasks->try_enqueue(task))
+            this->push_overflow(task);
+    }
+
+    void SharedTasks::enqueue(std::coroutine_handle<>&& task)
+    {
+        if (!this->detachedTasks->try_enqueue(task))
+            this->push_overflow(task);
+    }
 
-    bool SharedTasks::dequeue(std::coroutine_handle<>& task) { return this->detachedTasks->try_dequeue(task); }
+    void SharedTasks::enqueue_bulk(const std::coroutine_handle<>* tasks, size_t n)
+    {
+        while (n > 0)
+        {
+            const size_t k = this->detachedTasks->try_enqueue_bulk(tasks, n);
+            if (k == 0)
+                break;
+            tasks += k;
+            n -= k;
+        }
+        if (n == 0)
+            return;
 
-    std::size_t SharedTasks::getSize() { return this->detachedTasks->size(); }
+        std::lock_guard lock(this->overflow_mtx_);
+        this->overflow_.insert(this->overflow_.end(), tasks, tasks + n);
+        this->overflow_size_.fetch_add(n, std::memory_order_release);
+    }
 
-    void SharedTasks::enqueue(std::coroutine_handle<>&& task) { this->detachedTasks->try_enqueue(task); }
+    bool SharedTasks::try_enqueue(std::coroutine_handle<> task)
+    {
+        if (this->overflow_size_.load(std::memory_order_acquire) > 0)
+            return false;
+        return this->detachedTasks->try_enqueue(task);
+    }
 
-    bool SharedTasks::dequeue(std::coroutine_handle<>&& task) { return this->detachedTasks->try_dequeue(task); }
+    bool SharedTasks::dequeue(std::coroutine_handle<>& task)
+    {
+        return this->detachedTasks->try_dequeue(task) || this->pop_overflow(&task, 1) > 0;
+    }
 
-    bool SharedTasks::dequeue_bulk(queue::single_thread::Queue<std::coroutine_handle<>>* q)
+    std::size_t SharedTasks::getSize()
     {
-        static constexpr size_t kDrainBatch = 64;
-        std::coroutine_handle<> batch[kDrainBatch];
-        size_t got{0};
-        if (got = this->detachedTasks->try_dequeue_bulk(batch, kDrainBatch); got > 0)
-            q->enqueue_bulk(batch, got);
-        return got > 0;
+        return this->detachedTasks->size() + this->overflow_size_.load(std::memory_order_acquire);
+    }
+
+    bool SharedTasks::dequeue(std::coroutine_handle<>&& task) { return this->dequeue(task); }
+
+    size_t SharedTasks::dequeue_bulk(std::coroutine_handle<>* out, size_t max_items)
+    {
+        size_t got = this->detachedTasks->try_dequeue_bulk(out, max_items);
+        if (got < max_items)
+            got += this->pop_overflow(out + got, max_items - got);
+        return got;
+    }
+
+    void SharedTasks::push_overflow(std::coroutine_handle<> task)
+    {
+        std::lock_guard lock(this->overflow_mtx_);
+        this->overflow_.push_back(task);
+        this->overflow_size_.fetch_add(1, std::memory_order_release);
+    }
+
+    size_t SharedTasks::pop_overflow(std::coroutine_handle<>* out, size_t max_items)
+    {
+        if (this->overflow_size_.load(std::memory_order_acquire) == 0)
+            return 0;
+
+        // the list is cold: wait for the lock rather than report it empty and let the caller park
+        std::lock_guard lock(this->overflow_mtx_);
+
+        size_t n = 0;
+        while (n < max_items && !this->overflow_.empty())
+        {
+            out[n++] = this->overflow_.front();
+            this->overflow_.pop_front();
+        }
+        this->overflow_size_.fetch_sub(n, std::memory_order_release);
+        return n;
     }
 } // namespace usub::uvent::task
@@ -17,17 +17,20 @@ namespace usub::uvent::utils
     {
         auto aw = timeout_coroutine(std::move(f), arg);
         this->coro = aw.get_promise()->get_coroutine_handle();
+        this->priority = aw.get_promise()->get_priority();
     }
 
     void Timer::addFunction(std::function<void(std::any&)> f, std::any& arg)
     {
         auto aw = timeout_coroutine(std::move(f), arg);
         this->coro = aw.get_promise()->get_coroutine_handle();
+        this->priority = aw.get_promise()->get_priority();
     }
 
-    void Timer::bind(std::coroutine_handle<> h) noexcept
+    void Timer::bind(std::coroutine_handle<> h, task::Priority priority) noexcept
     {
         this->coro = h;
+        this->priority = priority;
         this->active = true;
     }
 }
@@ -3,6 +3,8 @@
 //
 
 #include "uvent/utils/timer/TimerWheel.h"
+#include "uvent/system/SystemContext.h"
+#include "uvent/utils/trace/Trace.h"
 
 namespace usub::uvent::utils
 {
@@ -170,7 +172,7 @@ namespace usub::uvent::utils
     }
 
 
-    void TimerWheel::tick()
+    size_t TimerWheel::tick()
     {
         for (;;)
         {
@@ -259,7 +261,7 @@ namespace usub::uvent::utils
         if (elapsed == 0)
         {
             updateNextExpiryTime();
-            return;
+            return 0;
         }
 
         this->currentTime_ = newTime;
@@ -268,13 +270,16 @@ namespace usub::uvent::utils
         if (ticks == 0)
             ticks = 1;
 
+        size_t fired = 0;
         for (uint64_t i = 0; i < ticks; ++i)
-            advance();
+            fired += advance();
+        return fired;
     }
 
 
-    void TimerWheel::advance()
+    size_t TimerWheel::advance()
     {
+        size_t fired = 0;
         for (auto& wheel : this->wheels_)
         {
             auto& bucket = wheel.buckets_[wheel.currentSlot_];
@@ -291,12 +296,16 @@ namespace usub::uvent::utils
                 if (is_due(this->currentTime_, timer->expiryTime, wheel.interval_))
                 {
                     if (timer->coro)
-                        system::this_thread::detail::q->enqueue(timer->coro);
+                    {
+                        system::this_thread::detail::enqueue_ready(timer->coro, timer->priority);
+                        UVENT_TRACE_INSTANT(TIMER_FIRE, timer->coro.address(), timer->id);
+                    }
                     timer->active = false;
                     this->timerMap_.erase(timer->id);
                     --this->activeTimerCount_;
                     delete timer;
                     it = bucket.erase(it);
+                    ++fired;
                 }
                 else
                 {
@@ -311,6 +320,7 @@ namespace usub::uvent::utils
         }
 
         updateNextExpiryTime();
+        return fired;
     }
 
     bool TimerWheel::empty() const
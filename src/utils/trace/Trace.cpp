@@ -0,0 +1,142 @@
+//
+// Created by root on 10/16/26.
+//
+
+#include "uvent/utils/trace/Trace.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include "uvent/system/Settings.h"
+#include "uvent/system/SystemContext.h"
+
+namespace usub::uvent::utils::trace
+{
+    namespace
+    {
+        std::mutex registry_mtx;
+        std::vector<std::unique_ptr<TraceBuffer>> registry;
+        int next_foreign_tid = 1000;
+
+        const char* event_name(EventType type)
+        {
+            switch (type)
+            {
+            case EventType::RESUME:
+                return "resume";
+            case EventType::POLL:
+                return "poll";
+            case EventType::TIMER_FIRE:
+                return "timer_fire";
+            case EventType::IO_READY:
+                return "io_ready";
+            }
+            return "unknown";
+        }
+    } // namespace
+
+    TraceBuffer::TraceBuffer(int tid, size_t capacity) :
+        tid_(tid), mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), events_(new Event[mask_ + 1])
+    {
+    }
+
+    std::vector<Event> TraceBuffer::snapshot() const
+    {
+        const uint64_t head = this->head_.load(std::memory_order_acquire);
+        const uint64_t cap = this->mask_ + 1;
+        uint64_t from = this->tail_.load(std::memory_order_relaxed);
+        if (head - from > cap)
+            from = head - cap;
+
+        std::vector<Event> out;
+        out.reserve(head - from);
+        for (uint64_t i = from; i < head; ++i)
+            out.push_back(this->events_[i & this->mask_]);
+        return out;
+    }
+
+    uint64_t now_ns() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    TraceBuffer& local_buffer()
+    {
+        thread_local TraceBuffer* buffer = nullptr;
+        if (!buffer)
+        {
+            std::lock_guard lock(registry_mtx);
+            const int tid = system::this_thread::detail::t_id >= 0 ? system::this_thread::detail::t_id
+                                                                   : next_foreign_tid++;
+            registry.push_back(
+                std::make_unique<TraceBuffer>(tid, static_cast<size_t>(settings::trace_buffer_events)));
+            buffer = registry.back().get();
+        }
+        return *buffer;
+    }
+
+    bool dump_chrome_trace(const std::string& path)
+    {
+        FILE* f = std::fopen(path.c_str(), "w");
+        if (!f)
+            return false;
+
+        std::lock_guard lock(registry_mtx);
+        std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+        bool first = true;
+        for (const auto& buffer : registry)
+        {
+            std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s%d\"}}",
+                         first ? "" : ",\n", buffer->tid(), buffer->tid() < 1000 ? "uvent_worker_" : "thread_",
+                         buffer->tid());
+            first = false;
+
+            for (const auto& e : buffer->snapshot())
+            {
+                const double ts_us = static_cast<double>(e.ts_ns) / 1000.0;
+                const char* name = event_name(e.type);
+                switch (e.type)
+                {
+                case EventType::RESUME:
+                    std::fprintf(f,
+                                 ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                                 "\"args\":{\"coro\":\"%p\",\"priority\":%lld}}",
+                                 name, buffer->tid(), ts_us, static_cast<double>(e.dur_ns) / 1000.0, e.subject,
+                                 static_cast<long long>(e.arg));
+                    break;
+                case EventType::POLL:
+                    std::fprintf(f,
+                                 ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                                 "\"args\":{\"timeout_ms\":%lld}}",
+                                 name, buffer->tid(), ts_us, static_cast<double>(e.dur_ns) / 1000.0,
+                                 static_cast<long long>(e.arg));
+                    break;
+                case EventType::TIMER_FIRE:
+                    std::fprintf(f,
+                                 ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                                 "\"args\":{\"coro\":\"%p\",\"timer_id\":%lld}}",
+                                 name, buffer->tid(), ts_us, e.subject, static_cast<long long>(e.arg));
+                    break;
+                case EventType::IO_READY:
+                    std::fprintf(f,
+                                 ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                                 "\"args\":{\"coro\":\"%p\",\"fd\":%lld}}",
+                                 name, buffer->tid(), ts_us, e.subject, static_cast<long long>(e.arg));
+                    break;
+                }
+            }
+        }
+        std::fputs("\n]}\n", f);
+        return std::fclose(f) == 0;
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(registry_mtx);
+        for (auto& buffer : registry)
+            buffer->clear();
+    }
+} // namespace usub::uvent::utils::trace